@@ -15,137 +15,188 @@
 
 const char* DarkSkyAPI::Location::Kiel = "54.3422,10.1375"; //Kiel, Blücherplatz
 
-DarkSkyAPI::DarkSkyAPI(HTTPClient& http): _http(http)
+DarkSkyAPI::DarkSkyAPI()
 {
 }
 
+/**
+  Reads the forecast from the gateway on host instead of DarkSky. The gateway
+  sends it as a record of a few hundred bytes, tools/host/gateway.cpp.
+*/
+void DarkSkyAPI::useGateway(const char* host, uint16_t port)
+{
+  _gatewayHost = host;
+  _gatewayPort = port;
+}
+
+/**
+  Path of the DarkSky query for location.
+*/
+String DarkSkyAPI::queryPath(const char* location)
+{
+  return String(_apiLink) + String(location) + "/" + String(_apiOptions);
+}
+
+/**
+  Reads the weather and waits until it is received.
+*/
 bool DarkSkyAPI::queryWeather(const char* location)
 {
-  httpsQueryOnAPI(location, 0);
-  _actualWeather.location = "Kiel";
-  _actualWeather.actDesc = listener.getDesc();
-  _actualWeather.actIco = listener.getIcon();
-  _actualWeather.actTemp = listener.getTemperature();
-  _actualWeather.actWindSpd = listener.getWindSpd();
-  _actualWeather.actWindDir = listener.getWindDir();
-  int timezone = listener.getTimezone();
-  // If NTP time fails, use current weather timestamp
-  if (UTCmidnightTime < 86400) 
-  {
-    UTCmidnightTime = listener.getCurrentTime();
-    if (timeStatus() == timeNotSet) setTime(listener.getCurrentTime()+3600*timezone);
-    }
-  
-  
-  int row,i;
-  for (i = 0; i<2; i++)
+  if (!beginQuery(location)) return false;
+  while (busy()) update(100);
+  return (_fetch.state() == HttpFetch::DONE);
+}
+
+/**
+  Starts reading the weather, update() does the work. One request returns the
+  current weather and the hourly forecast.
+*/
+bool DarkSkyAPI::beginQuery(const char* location)
+{
+  if (DEBUG_DarkSkyAPI) Serial.println("Free Heap: " + String(ESP.getFreeHeap()));
+  if (_gatewayHost)
   {
-    httpsQueryOnAPI(location, UTCmidnightTime+24*i*3600);
-    for (row=0; row < 24; row++)
-    {
-      _actualWeather.fTemp[row+24*i] = listener.getFutureTemp(row);
-      _actualWeather.fRainProb[row+24*i] = listener.getFutureRainProb(row);
-      _actualWeather.fRainInt[row+24*i] = listener.getFutureRainInt(row);
-      _actualWeather.fWindSpd[row+24*i] = listener.getFutureWindSpd(row);
-      _actualWeather.fWindDir[row+24*i] = listener.getFutureWindDir(row);
-      _actualWeather.fCloudCover[row+24*i] = listener.getFutureCloudCover(row);
-    }
+    if (!_fetch.begin(_gatewayClient, _gatewayHost, _gatewayPort, "/weather/" + String(location), &_record, DARKSKY_QUERY_TIMEOUT)) return false;
+    _record.begin();
+    return true;
   }
-  
-  if (DEBUG_DarkSkyAPI) Serial.println(printWeather());
+  return _fetch.begin(_client, _apiHost, _httpsPort, queryPath(location), &listener, DARKSKY_QUERY_TIMEOUT);
 }
 
-bool DarkSkyAPI::httpsQueryOnAPI(const char* location, uint32_t startTime)
+/**
+  Continues the running query for at most budget ms. Returns DONE once, when
+  the forecast has been updated, FAILED if the query broke off.
+*/
+HttpFetch::State DarkSkyAPI::update(uint32_t budget)
 {
-  // Use WiFiClientSecure class to create TLS connection
-  WiFiClientSecure client;
-  if (DEBUG_DarkSkyAPI) Serial.print("connecting to ");
-  if (DEBUG_DarkSkyAPI) Serial.println(_apiHost);
-  if (!client.connect(_apiHost, _httpsPort)) {
-    Serial.println("connection failed");
-    return false;
-  }
-  if (DEBUG_DarkSkyAPI) {
-    if (client.verify(_apiHostFingerprint, _apiHost)) {
+  if (!busy()) return _fetch.state();
+
+  HttpFetch::State state = _fetch.update(budget);
+  if (DEBUG_DarkSkyAPI && (state == HttpFetch::SEND)) {
+    if (_client.verify(_apiHostFingerprint, _apiHost)) {
       Serial.println("certificate matches");
     } else {
       Serial.println("certificate doesn't match");
     }
   }
-  String sTime = "", excl = ",hourly";
-  if (startTime > 0) 
+  if (state == HttpFetch::DONE)
   {
-    sTime = "," + String(startTime);
-    excl = "";
+    if (!_gatewayHost) readForecast();
+    // A broken record keeps the forecast
+    else if (!readRecord()) _fetch.abort();
   }
-  
-  String apiAddress = String(_apiLink) + String(location) + sTime + "/" + String(_apiOptions) + excl;
-  if (DEBUG_DarkSkyAPI) Serial.print("requesting URL: ");
-  if (DEBUG_DarkSkyAPI) Serial.println(apiAddress);
+  state = _fetch.state();
+  if (DEBUG_DarkSkyAPI && !busy()) Serial.println("Free Heap: " + String(ESP.getFreeHeap()));
+  return state;
+}
 
-  client.print(String("GET ") + apiAddress + " HTTP/1.1\r\n" +
-               "Host: " + _apiHost + "\r\n" +
-               "User-Agent: BuildFailureDetectorESP8266\r\n" +
-               "Connection: close\r\n\r\n");
+bool DarkSkyAPI::busy()
+{
+  return _fetch.busy();
+}
 
-  if (DEBUG_DarkSkyAPI) Serial.println("request sent");
-  if (DEBUG_DarkSkyAPI) Serial.println("Free Heap: " + String(ESP.getFreeHeap()));
-  String line;
-  while (client.connected()) {
-    line = client.readStringUntil('\n');
-    if (DEBUG_DarkSkyAPI) Serial.println(line);
-    if (line == "\r") {
-      if (DEBUG_DarkSkyAPI) Serial.println("- headers received -");
-      break;
-    }
-  }
-  if (DEBUG_DarkSkyAPI) Serial.println("Start getting data");
-
-
-  if (DEBUG_DarkSkyAPI) Serial.println(String(ESP.getFreeHeap()));
-  parser.setListener(&listener);
-
-  boolean isBody = false;
-  char c;
-  int size = 0, index = 0;
-  if (DEBUG_DarkSkyAPI) Serial.print("Reading and parsing data from api.darksky.net...");
-
-  // Parse the JSON data retrieved from the server
-  while(client.connected()) {
-    while((size = client.available()) > 0) {
-      c = client.read();
-      if (c == '{' || c == '[') {
-        isBody = true;
-      }
-      if (isBody) {
-        parser.parse(c);
-      }
-    }
+/**
+  Takes the values of the listener into the forecast.
+*/
+void DarkSkyAPI::readForecast()
+{
+  WeatherForecast &w = _actualWeather;
+  w.changed = 0;
+  if (w.actIco != listener.getIcon()) w.changed |= WEATHER_CHANGED_ICON;
+  if (w.actTemp != listener.getTemperature()) w.changed |= WEATHER_CHANGED_TEMP;
+  w.actIco = listener.getIcon();
+  w.actTemp = listener.getTemperature();
+  w.actWindSpd = listener.getWindSpd();
+  w.actWindDir = listener.getWindDir();
+  // If NTP time fails, use current weather timestamp
+  if (timeStatus() == timeNotSet) setTime(listener.getCurrentTime() + 60L * listener.getOffset());
+  
+  // The forecast starts at local midnight today, given in hours since 1970 (UTC)
+  uint32_t startHour = listener.getStartHour();
+  
+  int row;
+  for (row=0; row < 48; row++)
+  {
+    uint32_t h = startHour + row;
+    // Hours of today that were never fetched show the current weather
+    bool known = listener.hasFuture(h);
+    int16_t temp = known ? listener.getFutureTemp(h) : w.actTemp;
+    uint8_t rainProb = known ? listener.getFutureRainProb(h) : 0;
+    uint8_t rainInt = known ? listener.getFutureRainInt(h) : 0;
+    uint8_t windSpd = known ? listener.getFutureWindSpd(h) : w.actWindSpd;
+    uint8_t windDir = known ? listener.getFutureWindDir(h) : w.actWindDir;
+
+    if (w.fTemp[row] != temp) w.changed |= WEATHER_CHANGED_FTEMP;
+    if ((w.fRainProb[row] != rainProb) || (w.fRainInt[row] != rainInt)) w.changed |= WEATHER_CHANGED_RAIN;
+    if ((w.fWindSpd[row] != windSpd) || (w.fWindDir[row] != windDir)) w.changed |= WEATHER_CHANGED_WIND;
+
+    w.fTemp[row] = temp;
+    w.fRainProb[row] = rainProb;
+    w.fRainInt[row] = rainInt;
+    w.fWindSpd[row] = windSpd;
+    w.fWindDir[row] = windDir;
+    w.fCloudCover[row] = known ? listener.getFutureCloudCover(h) : 0;
   }
-  if (DEBUG_DarkSkyAPI) Serial.println(" Done.");
-  if (DEBUG_DarkSkyAPI) Serial.println(String(ESP.getFreeHeap()));
   
-  // Reset the parser so that it starts from the beginning the next time around
-  parser.reset();
+  if (DEBUG_DarkSkyAPI) Serial.println(printWeather());
 }
 
-WeatherForecast DarkSkyAPI::readWeather()
+/**
+  Takes the forecast record of the gateway, returns false if it is invalid.
+*/
+bool DarkSkyAPI::readRecord()
+{
+  WeatherForecast w;
+  uint32_t localTime;
+  if (!_record.readWeather(w, localTime)) return false;
+
+  const WeatherForecast &old = _actualWeather;
+  w.changed = 0;
+  if (w.actIco != old.actIco) w.changed |= WEATHER_CHANGED_ICON;
+  if (w.actTemp != old.actTemp) w.changed |= WEATHER_CHANGED_TEMP;
+  if (memcmp(w.fTemp, old.fTemp, sizeof(w.fTemp)) != 0) w.changed |= WEATHER_CHANGED_FTEMP;
+  if ((memcmp(w.fRainProb, old.fRainProb, sizeof(w.fRainProb)) != 0) ||
+      (memcmp(w.fRainInt, old.fRainInt, sizeof(w.fRainInt)) != 0)) w.changed |= WEATHER_CHANGED_RAIN;
+  if ((memcmp(w.fWindSpd, old.fWindSpd, sizeof(w.fWindSpd)) != 0) ||
+      (memcmp(w.fWindDir, old.fWindDir, sizeof(w.fWindDir)) != 0)) w.changed |= WEATHER_CHANGED_WIND;
+  _actualWeather = w;
+
+  // If NTP time fails, use current weather timestamp
+  if (timeStatus() == timeNotSet) setTime(localTime);
+  
+  if (DEBUG_DarkSkyAPI) Serial.println(printWeather());
+  return true;
+}
+
+/**
+  The forecast is updated in place by queryWeather(), the reference stays valid.
+*/
+const WeatherForecast& DarkSkyAPI::readWeather()
 {
   return _actualWeather;
 }
 
+/**
+  Sets the forecast without a query, e.g. the one saved before a restart.
+*/
+void DarkSkyAPI::setWeather(const WeatherForecast& weather)
+{
+  _actualWeather = weather;
+  _actualWeather.changed = WEATHER_CHANGED_ALL;
+}
+
 String DarkSkyAPI::printWeather()
 {
   String wStr;
-  wStr += _actualWeather.location + ": " + _actualWeather.actDesc + " (" + String(_actualWeather.actTemp) + "°C, " + String(_actualWeather.actWindSpd) + "km/h aus " + String(_actualWeather.actWindDir) + "°)" + ":\n";
+  wStr += "Kiel: " + String(listener.getDesc()) + " (" + String(_actualWeather.actTemp / 10.0, 1) + "°C, " + String(_actualWeather.actWindSpd) + "km/h aus " + String(_actualWeather.actWindDir * 360 / 256) + "°)" + ":\n";
   for (int row=0; row < 48; row++)
   {
     wStr += String(row) + "h:\t";
-    wStr += String(_actualWeather.fTemp[row]) + "°C,\t";
+    wStr += String(_actualWeather.fTemp[row] / 10.0, 1) + "°C,\t";
     wStr += String(_actualWeather.fWindSpd[row]) + "km/h,\t";
-    wStr += String(_actualWeather.fWindDir[row]) + "°,\t";
+    wStr += String(_actualWeather.fWindDir[row] * 360 / 256) + "°,\t";
     wStr += String(_actualWeather.fRainProb[row]) + "%\t";
-    wStr += String(_actualWeather.fRainInt[row]) + "mm,\t";
+    wStr += String(_actualWeather.fRainInt[row] / 10.0, 1) + "mm,\t";
     wStr += "\n";   
   }
   return wStr;
@@ -12,6 +12,8 @@
 
 #define DEBUG_DarkSkyAPI 0
 
+#define DARKSKY_QUERY_TIMEOUT 20000  // Give up if a query takes longer than 20s
+
 #include "Arduino.h"
 #include <String.h>
 #include <TimeLib.h>
@@ -20,50 +22,67 @@
 // WIFI connection for ESP8266
 #include <ESP8266WiFi.h>
 #include <WiFiClientSecure.h>
-#include <ESP8266HTTPClient.h>
-// JSON parser library
-#include <JsonStreamingParser.h>
+// Non-blocking HTTP requests
+#include "HttpFetch.h"
+// Forecast records of the gateway
+#include "GatewayRecord.h"
+
+// Parts of WeatherForecast changed by the last query
+#define WEATHER_CHANGED_ICON  0x01
+#define WEATHER_CHANGED_TEMP  0x02
+#define WEATHER_CHANGED_FTEMP 0x04
+#define WEATHER_CHANGED_RAIN  0x08
+#define WEATHER_CHANGED_WIND  0x10
+#define WEATHER_CHANGED_ALL   0x1F
 
 typedef struct WeatherForecast 
 {
-  String location;
-  String actDesc;
-  String actIco;
-  float actTemp;
-  int actWindSpd;
-  int actWindDir;
-  float fTemp[48];
-  float fRainProb[48];
-  float fRainInt[48];
-  int fWindSpd[48];
-  int fWindDir[48];
-  int fCloudCover[48];
+  uint8_t changed;                // WEATHER_CHANGED_* flags
+  WeatherIcon actIco;
+  int16_t actTemp;                // 0.1 °C
+  uint8_t actWindSpd;             // km/h
+  uint8_t actWindDir;             // 256 steps per turn
+  int16_t fTemp[48];              // 0.1 °C
+  uint8_t fRainProb[48];          // %
+  uint8_t fRainInt[48];           // 0.1 mm/h
+  uint8_t fWindSpd[48];           // km/h
+  uint8_t fWindDir[48];           // 256 steps per turn
+  uint8_t fCloudCover[48];        // %
 };
 
 class DarkSkyAPI
 {
   public:
-    DarkSkyAPI(HTTPClient& http);
+    DarkSkyAPI();
+    void useGateway(const char* host, uint16_t port);
+    String queryPath(const char* location);
     bool queryWeather(const char* location);
-    WeatherForecast readWeather();
+    bool beginQuery(const char* location);
+    HttpFetch::State update(uint32_t budget);
+    bool busy();
+    const WeatherForecast& readWeather();
+    void setWeather(const WeatherForecast& weather);
     String printWeather();
     DataListener listener;
-    uint32_t UTCmidnightTime = 0;
     struct Location
     {
       static const char* Kiel;
     };
   private:
-    JsonStreamingParser parser;
-    WeatherForecast parseDarkSkyString(String jsonStr);
-    bool httpsQueryOnAPI(const char* location, uint32_t startTime);
+    HttpFetch _fetch;
+    WiFiClientSecure _client;
+    WiFiClient _gatewayClient;
+    GatewayRecord _record;
+    const char* _gatewayHost = NULL;  // NULL to query DarkSky directly
+    uint16_t _gatewayPort;
+    void readForecast();
+    bool readRecord();
     const int _httpsPort = 443;
     const char* _apiLink = "/forecast/00112233445566778899aabbccddeeff/";
     const char* _apiHost = "api.darksky.net";
     const char* _apiHostFingerprint = "16 D2 B8 63 6A B7 05 26 96 CF BD 55 79 2C 52 24 2D 51 2B 3A";
-    const char* _apiOptions = "?lang=de&units=ca&exclude=minutely,daily,alerts,flags";
+    const char* _apiOptions = "?lang=de&units=ca&exclude=minutely,daily,alerts,flags&extend=hourly";
     WeatherForecast _actualWeather;
-    HTTPClient& _http;
 };
 
 
@@ -1,119 +1,185 @@
 /**
   DarkSky.net Data Listener Library
   Name: DarkSkyAPI_DataListener.cpp
-  Purpose: Data Listener for JSON parser library
+  Purpose: Reads the tokens of a DarkSky response
 
   @author basti8909
   @version 1.0 16/08/17
 */
 
 #include "DarkSkyAPI_DataListener.h"
-#include <JsonListener.h>
 
 #define PARSER_DEBUG false  //Set to true to view parsed data via serial output. WARNING: may cause major latency if baud rate is low!
 
-void DataListener::whitespace(char c) {
-  if(PARSER_DEBUG) Serial.println("whitespace");
-}
+// Keys that are read, in the order of JsonKey
+const char * const DataListener::keys[] = {"offset", "currently", "hourly", "data", "time", "summary", "icon",
+  "temperature", "windSpeed", "windBearing", "precipProbability", "precipIntensity", "cloudCover", NULL};
 
-void DataListener::startDocument() {
-  if(PARSER_DEBUG) Serial.println("start document");
+/**
+  Only the keys that are read are tokens, the tokenizer passes over the
+  values of the about 20 other keys of each hour.
+*/
+void DataListener::start(JsonTokenizer &json) {
+  json.select(keys);
 }
 
-void DataListener::key(String key) {
-  if(PARSER_DEBUG) Serial.println("key: " + key);
-  currentKey = String(key);
+/**
+  Takes the tokens of the received piece. Objects and arrays note their key
+  for the values inside.
+*/
+void DataListener::parse(JsonTokenizer &json) {
+  while(json.next())
+  {
+    if(PARSER_DEBUG) Serial.println(String(json.type()) + " " + json.key() + ": " + json.text());
+
+    switch(json.type())
+    {
+      case JsonTokenizer::BEGIN_OBJECT:
+      case JsonTokenizer::BEGIN_ARRAY:
+        if(json.depth() < LISTENER_DEPTH) parents[json.depth()] = (JsonKey)json.field();
+        break;
+
+      case JsonTokenizer::END_OBJECT:
+        if(json.depth() == 3) slot = -1;
+        break;
+
+      case JsonTokenizer::END_ARRAY:
+        break;
+
+      default:
+        value(json);
+        break;
+    }
+  }
 }
 
-void DataListener::value(String value) {
-  if(PARSER_DEBUG) Serial.println("value: " + value);
-
-  if(currentKey == "offset")
-    timezone = value.toInt();
+void DataListener::value(JsonTokenizer &json) {
+  JsonKey key = (JsonKey)json.field();
+  uint8_t depth = json.depth();
+  const char *v = json.text();
 
-  if(currentParent == "currently")
-  { 
-    if(currentKey == "time")
-      currentTime = value.toInt();
-      
-    if(currentKey == "temperature")
-      temperature = value.toFloat();
-
-    if(currentKey == "windSpeed")
-      windSpd = value.toInt();
-      
-    if(currentKey == "windBearing")
-      windDir = value.toInt();
-
-    if(currentKey == "icon")
-      icon = value;
+  // Values of the root object
+  if(depth == 1)
+  {
+    // Hours, not always whole ones, e.g. 5.5 or -3.5
+    if(key == KEY_OFFSET)
+    {
+      offset = toFixed(v, 2) * 60 / 100;
+      offsetKnown = true;
+    }
   }
-  if(currentParent == "hourly")
-  { 
-    if(currentKey == "summary")
-      desc = value;
+
+  // Values of "currently" and "hourly"
+  else if(depth == 2)
+  {
+    switch (parent(1) == KEY_CURRENTLY ? key : KEY_OTHER)
+    {
+      case KEY_TIME:          currentTime = strtoul(v, NULL, 10); break;
+      case KEY_TEMPERATURE:   temperature = toFixed(v, 1); break;
+      case KEY_WIND_SPEED:    windSpd = toFixed(v, 0); break;
+      case KEY_WIND_BEARING:  windDir = toDirection(v); break;
+      case KEY_ICON:          icon = iconFromString(v); break;
+      default: break;
+    }
+    if((parent(1) == KEY_HOURLY) && (key == KEY_SUMMARY))
+    {
+      strncpy(desc, v, LISTENER_DESC - 1);
+      desc[LISTENER_DESC - 1] = '\x00';
+    }
   }
 
-  if(enterArray)
+  // Values of an hourly forecast in "hourly.data"
+  else if((depth == 4) && (parent(2) == KEY_DATA) && (parent(1) == KEY_HOURLY))
   {
-      if(index < limit) // Skip the first hourly forecast (the same hour as the current hour)
+    // "time" is the first value of each forecast and selects the slot. Only
+    // the hours shown from local midnight on are kept, later ones would
+    // overwrite the earlier hours of today. They come in order, so the rest
+    // of "data" is skipped. "offset" is the last value of the response, the
+    // one of the previous response is used. Before the first one there are no
+    // earlier hours to keep.
+    if(key == KEY_TIME)
+    {
+      uint32_t hour = strtoul(v, NULL, 10) / 3600;
+      uint32_t startHour = offsetKnown ? getStartHour() : currentTime / 3600;
+      slot = -1;
+      if(hour < startHour + FORECAST_HOURS)
       {
-          if(currentKey == "time")
-          future_time[index] = value.toInt();
-          
-          if(currentKey == "temperature")
-          future_temp[index] = value.toFloat();
-          
-          if(currentKey == "precipProbability")
-          future_rainProb[index] = (value.toFloat()*100);
-          
-          if(currentKey == "precipIntensity")
-          future_rainInt[index] = value.toFloat();
-          
-          if(currentKey == "windSpeed")
-          future_windSpd[index] = value.toInt();
-          
-          if(currentKey == "windBearing")
-          future_windDir[index] = value.toInt();
-
-          if(currentKey == "cloudCover")
-          future_cloudCover[index] = (value.toFloat()*100);
+        slot = hour % FORECAST_HOURS;
+        future_hour[slot] = hour;
       }
-   }
-  
-}
-
-void DataListener::endArray() {
-  if(PARSER_DEBUG) Serial.println("end array. ");
-  enterArray = false;
-  index = 0;
+      else json.skipRest(2);
+    }
+    else if(slot >= 0)
+    {
+      switch (key)
+      {
+        case KEY_TEMPERATURE:         future_temp[slot] = toFixed(v, 1); break;
+        case KEY_PRECIP_PROBABILITY:  future_rainProb[slot] = toFixed(v, 2); break;
+        case KEY_PRECIP_INTENSITY:    future_rainInt[slot] = constrain(toFixed(v, 1), 0, 255); break;
+        case KEY_WIND_SPEED:          future_windSpd[slot] = toFixed(v, 0); break;
+        case KEY_WIND_BEARING:        future_windDir[slot] = toDirection(v); break;
+        case KEY_CLOUD_COVER:         future_cloudCover[slot] = toFixed(v, 2); break;
+        default: break;
+      }
+    }
+  }
 }
 
-void DataListener::endObject() {
-  if(PARSER_DEBUG) Serial.println("end object. ");
-  if(!enterArray) currentParent = "";
-  else index++;
+/**
+  Key of the enclosing object or array at the given level, the root is level 0.
+*/
+JsonKey DataListener::parent(uint8_t level) {
+  return (level < LISTENER_DEPTH) ? parents[level] : KEY_OTHER;
+}
+
+WeatherIcon DataListener::iconFromString(const char *icon) {
+  if (strcmp(icon, "clear-day") == 0)    return ICON_CLEAR_DAY;
+  if (strcmp(icon, "clear-night") == 0)    return ICON_CLEAR_NIGHT;
+  if (strcmp(icon, "rain") == 0)    return ICON_RAIN;
+  if (strcmp(icon, "snow") == 0)    return ICON_SNOW;
+  if (strcmp(icon, "sleet") == 0)    return ICON_SLEET;
+  if (strcmp(icon, "wind") == 0)    return ICON_WIND;
+  if (strcmp(icon, "fog") == 0)    return ICON_FOG;
+  if (strcmp(icon, "cloudy") == 0)    return ICON_CLOUDY;
+  if (strcmp(icon, "partly-cloudy-day") == 0)    return ICON_PARTLY_CLOUDY_DAY;
+  if (strcmp(icon, "partly-cloudy-night") == 0)    return ICON_PARTLY_CLOUDY_NIGHT;
+  if (strcmp(icon, "hail") == 0)    return ICON_HAIL;
+  if (strcmp(icon, "thunderstorm") == 0)    return ICON_THUNDERSTORM;  
+  else return ICON_UNKNOWN;
 }
 
-void DataListener::endDocument() {
-  if(PARSER_DEBUG) Serial.println("end document. ");
-}
+/**
+  Decimal number scaled by 10^decimals and rounded, e.g. ("12.34", 1) -> 123
+  or ("0.45", 2) -> 45. Exponents are not used by DarkSky and not supported.
+*/
+int32_t DataListener::toFixed(const char *value, uint8_t decimals) {
+  bool neg = (*value == '-');
+  if (neg) value++;
+
+  int32_t result = 0;
+  while ((*value >= '0') && (*value <= '9')) result = 10 * result + (*value++ - '0');
+  if (*value == '.') value++;
+  for (; decimals > 0; decimals--)
+  {
+    result *= 10;
+    if ((*value >= '0') && (*value <= '9')) result += *value++ - '0';
+  }
+  // Round half up with the next digit
+  if ((*value >= '5') && (*value <= '9')) result++;
 
-void DataListener::startArray() {
-   if(PARSER_DEBUG) Serial.println("start array. ");
-   enterArray = true;
+  return neg ? -result : result;
 }
 
-void DataListener::startObject() {
-   if(PARSER_DEBUG) Serial.println("start object. ");
-   currentParent = currentKey;
+// Bearing in degrees to 256 steps per turn
+uint8_t DataListener::toDirection(const char *value) {
+  return ((toFixed(value, 0) * 256 + 180) / 360) & 0xFF;
 }
 
-String DataListener::getDesc() {
+const char* DataListener::getDesc() {
     return desc;
 }
 
-String DataListener::getIcon() {
+WeatherIcon DataListener::getIcon() {
     return icon;
 }
 
@@ -121,11 +187,21 @@ uint32_t DataListener::getCurrentTime(){
     return currentTime;
 }
 
-uint8_t DataListener::getTimezone() {
-    return timezone;
+int16_t DataListener::getOffset() {
+    return offset;
 }
 
-double DataListener::getTemperature() {
+/**
+  Local midnight of today in hours since 1970 (UTC), the first hour of the
+  forecast that is shown.
+*/
+uint32_t DataListener::getStartHour() {
+    int32_t offsetSeconds = 60L * offset;
+    uint32_t localTime = currentTime + offsetSeconds;
+    return (localTime - localTime % 86400 - offsetSeconds) / 3600;
+}
+
+int16_t DataListener::getTemperature() {
     return temperature;
 }
 
@@ -133,30 +209,34 @@ uint8_t DataListener::getWindSpd() {
     return windSpd;
 }
 
-uint16_t DataListener::getWindDir() {
+uint8_t DataListener::getWindDir() {
     return windDir;
 }
 
-float DataListener::getFutureTemp(int i) {
-    return future_temp[i];
+bool DataListener::hasFuture(uint32_t hour) {
+    return future_hour[hour % FORECAST_HOURS] == hour;
+}
+
+int16_t DataListener::getFutureTemp(uint32_t hour) {
+    return future_temp[hour % FORECAST_HOURS];
 }
 
-uint8_t DataListener::getFutureRainProb(int i) {
-    return future_rainProb[i];
+uint8_t DataListener::getFutureRainProb(uint32_t hour) {
+    return future_rainProb[hour % FORECAST_HOURS];
 }
 
-float DataListener::getFutureRainInt(int i) {
-    return future_rainInt[i];
+uint8_t DataListener::getFutureRainInt(uint32_t hour) {
+    return future_rainInt[hour % FORECAST_HOURS];
 }
 
-uint8_t DataListener::getFutureWindSpd(int i) {
-    return future_windSpd[i];
+uint8_t DataListener::getFutureWindSpd(uint32_t hour) {
+    return future_windSpd[hour % FORECAST_HOURS];
 }
 
-uint16_t DataListener::getFutureWindDir(int i) {
-    return future_windDir[i];
+uint8_t DataListener::getFutureWindDir(uint32_t hour) {
+    return future_windDir[hour % FORECAST_HOURS];
 }
 
-uint8_t DataListener::getFutureCloudCover(int i) {
-    return future_cloudCover[i];
+uint8_t DataListener::getFutureCloudCover(uint32_t hour) {
+    return future_cloudCover[hour % FORECAST_HOURS];
 }
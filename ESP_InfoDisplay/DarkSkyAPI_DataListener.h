@@ -1,7 +1,7 @@
 /**
   DarkSky.net Data Listener Library Header
   Name: DarkSkyAPI_DataListener.h
-  Purpose: Data Listener for JSON parser library
+  Purpose: Reads the tokens of a DarkSky response
 
   @author basti8909
   @version 1.0 16/08/17
@@ -9,54 +9,96 @@
 
 #pragma once
 
-#include <JsonListener.h>
+#include "HttpFetch.h"
 
-class DataListener: public JsonListener {
+#define FORECAST_HOURS 48         // Size of the hourly forecast ring
+#define LISTENER_DEPTH 6          // Nesting levels of objects and arrays that are tracked
+#define LISTENER_DESC  80         // Maximum length of the forecast summary
+
+// DarkSky weather icons
+enum WeatherIcon : uint8_t
+{
+  ICON_CLEAR_DAY,
+  ICON_CLEAR_NIGHT,
+  ICON_RAIN,
+  ICON_SNOW,
+  ICON_SLEET,
+  ICON_WIND,
+  ICON_FOG,
+  ICON_CLOUDY,
+  ICON_PARTLY_CLOUDY_DAY,
+  ICON_PARTLY_CLOUDY_NIGHT,
+  ICON_HAIL,
+  ICON_THUNDERSTORM,
+  ICON_UNKNOWN
+};
+
+// JSON keys used by the listener in the order of DataListener::keys, the values
+// of all other keys are skipped
+enum JsonKey : uint8_t
+{
+  KEY_OTHER,
+  KEY_OFFSET,
+  KEY_CURRENTLY,
+  KEY_HOURLY,
+  KEY_DATA,
+  KEY_TIME,
+  KEY_SUMMARY,
+  KEY_ICON,
+  KEY_TEMPERATURE,
+  KEY_WIND_SPEED,
+  KEY_WIND_BEARING,
+  KEY_PRECIP_PROBABILITY,
+  KEY_PRECIP_INTENSITY,
+  KEY_CLOUD_COVER
+};
+
+class DataListener: public JsonHandler {
 
   private:
-    String currentKey;
-    String currentParent = "";
+    JsonKey parents[LISTENER_DEPTH];  // Keys of the enclosing objects and arrays
     uint32_t currentTime;
-    String desc;
-    String icon;
-    uint8_t timezone;
-    double temperature;
-    uint8_t windSpd;
-    uint16_t windDir;
-    int limit = 25;
-    long future_time[24];      // Array to store the time of future forecasts
-    float future_temp[24];
-    uint8_t future_rainProb[24];
-    float future_rainInt[24];
-    uint8_t future_windSpd[24];
-    uint16_t future_windDir[24];
-    uint8_t future_cloudCover[24];
-    bool enterArray = false;
+    char desc[LISTENER_DESC];
+    WeatherIcon icon = ICON_UNKNOWN;
+    int16_t offset;               // Local time minus UTC in minutes
+    bool offsetKnown = false;     // An offset has been read
+    int16_t temperature;          // 0.1 °C
+    uint8_t windSpd;              // km/h
+    uint8_t windDir;              // 256 steps per turn
+    // Hourly forecasts, the slot is the hour since 1970 modulo FORECAST_HOURS
+    uint32_t future_hour[FORECAST_HOURS];
+    int16_t future_temp[FORECAST_HOURS];
+    uint8_t future_rainProb[FORECAST_HOURS];
+    uint8_t future_rainInt[FORECAST_HOURS];
+    uint8_t future_windSpd[FORECAST_HOURS];
+    uint8_t future_windDir[FORECAST_HOURS];
+    uint8_t future_cloudCover[FORECAST_HOURS];
+    int slot = -1;                // Slot of the hourly forecast being parsed
+    void value(JsonTokenizer &json);
+    JsonKey parent(uint8_t level);
+    static const char * const keys[];
 
   public:
-    int index = 0;
-    virtual void whitespace(char c);
-    virtual void startDocument();
-    virtual void key(String key);
-    virtual void value(String value);
-    virtual void endArray();
-    virtual void endObject();
-    virtual void endDocument();
-    virtual void startArray();
-    virtual void startObject();
+    virtual void start(JsonTokenizer &json);
+    virtual void parse(JsonTokenizer &json);
+    static WeatherIcon iconFromString(const char *icon);
+    static int32_t toFixed(const char *value, uint8_t decimals);
+    static uint8_t toDirection(const char *value);
 
     // Functions to retrieve parsed data
-    String getDesc();
-    String getIcon();
+    const char* getDesc();
+    WeatherIcon getIcon();
     uint32_t getCurrentTime();
-    uint8_t getTimezone();
-    double getTemperature();
+    int16_t getOffset();
+    uint32_t getStartHour();
+    int16_t getTemperature();
     uint8_t getWindSpd();
-    uint16_t getWindDir();
-    float getFutureTemp(int i);
-    uint8_t getFutureRainProb(int i);
-    float getFutureRainInt(int i);
-    uint8_t getFutureWindSpd(int i);
-    uint16_t getFutureWindDir(int i);
-    uint8_t getFutureCloudCover(int i);
+    uint8_t getWindDir();
+    bool hasFuture(uint32_t hour);
+    int16_t getFutureTemp(uint32_t hour);
+    uint8_t getFutureRainProb(uint32_t hour);
+    uint8_t getFutureRainInt(uint32_t hour);
+    uint8_t getFutureWindSpd(uint32_t hour);
+    uint8_t getFutureWindDir(uint32_t hour);
+    uint8_t getFutureCloudCover(uint32_t hour);
 };
@@ -44,30 +44,31 @@ void Base::clearScreen()
   _Disp->fillScreen(TFT_BLACK);
 }
 
-void Base::drawXbm(int x, int y, int width, int height, const char *xbm, uint32_t color) {
-  if (width % 8 != 0) {
-    width =  ((width / 8) + 1) * 8;
-  }
-  for (int i = 0; i < width * height / 8; i++ ){
-    unsigned char charColumn = pgm_read_byte(xbm + i);
-    for (int j = 0; j < 8; j++) { 
-      int targetX = (i * 8 + (7-j)) % width + x;
-      int targetY = (8 * i / (width)) + y;
-      if (bitRead(charColumn, j)) {
-        _Disp->drawPixel(targetX, targetY,color);
-      }
-    }
-  }    
+/**
+  Draws a run length encoded image from icons_rle.h, only the foreground
+  runs are drawn.
+*/
+void Base::drawRle(int x, int y, int width, int height, const uint8_t *rle, uint32_t color) {
+  _Disp->drawRLE(x, y, rle, width, height, color, color);
+}
+
+/**
+  Draws a run length encoded image with a background colour, each run is one
+  block write into a single window.
+*/
+void Base::drawRle(int x, int y, int width, int height, const uint8_t *rle, uint32_t color, uint32_t bgColor) {
+  _Disp->drawRLE(x, y, rle, width, height, color, bgColor);
 }
-void Base::drawCenterXbm(int width, int height, const char *xbm, uint32_t color) {
+
+void Base::drawCenterRle(int width, int height, const uint8_t *rle, uint32_t color) {
   int x = _Disp->width()/2-width/2;
   int y = _Disp->height()/2-height/2;
   
-  drawXbm(x, y, width, height, xbm, color);  
+  drawRle(x, y, width, height, rle, color);  
 }
 
-void Base::drawLogoSpinner(int count, const char *logo, int lw, int lh) {
-  if (count == 0) drawXbm(_Disp->width()/2-lw/2,_Disp->height()/2-lh/2, lw, lh, logo,TFT_WHITE);
+void Base::drawLogoSpinner(int count, const uint8_t *logo, int lw, int lh) {
+  if (count == 0) drawRle(_Disp->width()/2-lw/2,_Disp->height()/2-lh/2, lw, lh, logo,TFT_WHITE,TFT_BLACK);
   for (int i = 0; i < 3; i++) {
     //const char *xbm;
     int x = _Disp->width()/2 + 16 * (i-1);
@@ -81,32 +82,240 @@ void Base::drawLogoSpinner(int count, const char *logo, int lw, int lh) {
   }   
 }
 
-void Base::drawWeatherIcon(int x, int y, String weatherIcon, uint32_t color)
+void Base::drawWeatherIcon(int x, int y, WeatherIcon weatherIcon, uint32_t color)
+{
+  drawRle(x, y, wIco_width, wIco_height, getIconRle(weatherIcon), color);
+}
+
+
+/**
+  Marks an area of the screen as changed. Overlapping and adjacent areas are
+  merged so that flush() sends each pixel at most once.
+*/
+void Base::markDirty(int x, int y, int w, int h)
+{
+  // Clip to the display
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _Disp->width())  w = _Disp->width() - x;
+  if (y + h > _Disp->height()) h = _Disp->height() - y;
+  if (w < 1 || h < 1) return;
+
+  DirtyRect r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+  int best = -1;
+  int32_t bestGrowth = 0x7FFFFFFF;
+
+  for (int i = 0; i < _nDirty; i++)
+  {
+    DirtyRect &d = _dirty[i];
+    int x1 = min(r.x, d.x), y1 = min(r.y, d.y);
+    int x2 = max(r.x + r.w, d.x + d.w), y2 = max(r.y + r.h, d.y + d.h);
+    int32_t growth = (int32_t)(x2 - x1) * (y2 - y1) - (int32_t)d.w * d.h - (int32_t)r.w * r.h;
+    bool overlap = (r.x < d.x + d.w) && (d.x < r.x + r.w) && (r.y < d.y + d.h) && (d.y < r.y + r.h);
+    
+    // Merge overlapping areas and areas sharing a whole edge, the result may
+    // touch another tracked area so start again with the merged area
+    if (overlap || growth <= 0)
+    {
+      _dirty[i] = _dirty[--_nDirty];
+      markDirty(x1, y1, x2 - x1, y2 - y1);
+      return;
+    }
+    if (growth < bestGrowth) { bestGrowth = growth; best = i; }
+  }
+
+  // List is full, merge with the area that grows least
+  if (_nDirty == DIRTY_RECTS_MAX)
+  {
+    DirtyRect d = _dirty[best];
+    _dirty[best] = _dirty[--_nDirty];
+    markDirty(min(r.x, d.x), min(r.y, d.y), max(r.x + r.w, d.x + d.w) - min(r.x, d.x), max(r.y + r.h, d.y + d.h) - min(r.y, d.y));
+    return;
+  }
+  _dirty[_nDirty++] = r;
+}
+
+/**
+  Returns true if the area is part of the screen that is being flushed. Used by
+  Render() to skip elements that have not changed.
+*/
+bool Base::isDirty(int x, int y, int w, int h)
+{
+  return (x < _clip.x + _clip.w) && (_clip.x < x + w) && (y < _clip.y + _clip.h) && (_clip.y < y + h);
+}
+
+/**
+  Redraws all areas marked by markDirty(). Each area is rendered off-screen in
+  bands of at most DIRTY_BUFFER_PIXELS and sent with a single window per band.
+*/
+void Base::flush()
+{
+  if (_nDirty == 0) return;
+
+  // The areas are drawn together with the other elements by endTransition()
+  if (_screen->_transition)
+  {
+    _screen->addLayer(this);
+    return;
+  }
+
+  TFT_eSPI *disp = _Disp;
+  uint32_t bytes = disp->spiBytes();
+
+  for (int i = 0; i < _nDirty; i++)
+  {
+    DirtyRect r = _dirty[i];
+    int bandHeight = min(DIRTY_BUFFER_PIXELS / r.w, (int)r.h);
+
+    TFT_eSprite spr(disp);
+    if (spr.createWindow(r.x, r.y, r.w, r.h, bandHeight))
+    {
+      _Disp = &spr;
+      for (int band = 0; band < spr.bands(); band++)
+      {
+        spr.selectBand(band);
+        _clip.x = r.x;
+        _clip.y = r.y + band * bandHeight;
+        _clip.w = r.w;
+        _clip.h = min(bandHeight, r.h - band * bandHeight);
+        spr.fillSprite(_bgColor);
+        Render();
+        spr.pushSprite();
+      }
+      _Disp = disp;
+      spr.deleteSprite();
+    }
+    else
+    {
+      // Not enough RAM, draw straight to the display
+      _clip = r;
+      _Disp->fillRect(r.x, r.y, r.w, r.h, _bgColor);
+      Render();
+    }
+  }
+
+  _nDirty = 0;
+  _clip = (DirtyRect) {0, 0, 0x7FFF, 0x7FFF};
+  _frameBytes = disp->spiBytes() - bytes;
+  if (DEBUG_Display) Serial.println("Frame: " + String(_frameBytes) + " SPI bytes");
+}
+
+/**
+  Starts a change to another screen. Until endTransition() the elements only
+  mark their areas in Draw(), nothing is sent to the display.
+*/
+void Base::beginTransition()
+{
+  _transition = true;
+}
+
+/**
+  Shows the screen built since beginTransition() without clearing the display
+  first. The whole screen is rendered off-screen in full width bands and sent
+  from top to bottom, so the old screen is replaced band by band. In every band
+  the elements draw in the order their Draw() was called, parts no element
+  marked are black. Does nothing if no transition was started.
+*/
+void Base::endTransition()
+{
+  if (!_transition) return;
+  _transition = false;
+
+  TFT_eSPI *disp = _Disp;
+  uint32_t bytes = disp->spiBytes();
+  int w = disp->width(), h = disp->height();
+  int bandHeight = DIRTY_BUFFER_PIXELS / w;
+
+  TFT_eSprite spr(disp);
+  if (spr.createWindow(0, 0, w, h, bandHeight))
+  {
+    for (int band = 0; band < spr.bands(); band++)
+    {
+      DirtyRect r = {0, (int16_t)(band * bandHeight), (int16_t)w, (int16_t)min(bandHeight, h - band * bandHeight)};
+      spr.selectBand(band);
+      spr.fillSprite(TFT_BLACK);
+      for (int i = 0; i < _nLayers; i++) _layers[i]->renderBand(&spr, r);
+      spr.pushSprite();
+    }
+    spr.deleteSprite();
+    for (int i = 0; i < _nLayers; i++) _layers[i]->_nDirty = 0;
+  }
+  else
+  {
+    // Not enough RAM, clear the display and draw the elements one by one
+    disp->fillScreen(TFT_BLACK);
+    for (int i = 0; i < _nLayers; i++) _layers[i]->flush();
+  }
+
+  _nLayers = 0;
+  _frameBytes = disp->spiBytes() - bytes;
+  if (DEBUG_Display) Serial.println("Transition: " + String(_frameBytes) + " SPI bytes");
+}
+
+void Base::addLayer(Base *layer)
 {
-  drawXbm(x, y, 80, 80, getIconFromString(weatherIcon), color);
+  for (int i = 0; i < _nLayers; i++)
+    if (_layers[i] == layer) return;
+  if (_nLayers < TRANSITION_LAYERS) _layers[_nLayers++] = layer;
 }
 
+/**
+  Renders the marked areas of this element inside one band of a transition,
+  each area is cleared with the background colour of the element first.
+*/
+void Base::renderBand(TFT_eSPI *spr, DirtyRect band)
+{
+  TFT_eSPI *disp = _Disp;
+  _Disp = spr;
 
-const char* Base::getIconFromString(String icon) {
-  if (icon == "clear-day")    return wIco_clear_day_bits;
-  if (icon == "clear-night")    return wIco_clear_night_bits;
-  if (icon == "rain")    return wIco_rain_bits;
-  if (icon == "snow")    return wIco_snow_bits;
-  if (icon == "sleet")    return wIco_sleet_bits;
-  if (icon == "wind")    return wIco_wind_bits;
-  if (icon == "fog")    return wIco_fog_bits;
-  if (icon == "cloudy")    return wIco_cloudy_bits;
-  if (icon == "partly-cloudy-day")    return wIco_partly_cloudy_day_bits;
-  if (icon == "partly-cloudy-night")    return wIco_partly_cloudy_night_bits;
-  if (icon == "hail")    return wIco_hail_bits;
-  if (icon == "thunderstorm")    return wIco_thunderstorm_bits;  
-  else return wIco_partly_cloudy_day_bits;
+  for (int i = 0; i < _nDirty; i++)
+  {
+    DirtyRect d = _dirty[i];
+    int x1 = max(d.x, band.x), y1 = max(d.y, band.y);
+    int x2 = min(d.x + d.w, band.x + band.w), y2 = min(d.y + d.h, band.y + band.h);
+    if ((x2 <= x1) || (y2 <= y1)) continue;
+
+    _clip = (DirtyRect) {(int16_t)x1, (int16_t)y1, (int16_t)(x2 - x1), (int16_t)(y2 - y1)};
+    spr->fillRect(x1, y1, x2 - x1, y2 - y1, _bgColor);
+    Render();
+  }
+
+  _Disp = disp;
+  _clip = (DirtyRect) {0, 0, 0x7FFF, 0x7FFF};
+}
+
+/**
+  SPI bytes sent by the last flush(). Needs TFT_SPI_STATS in the TFT_eSPI setup.
+*/
+uint32_t Base::lastFrameBytes()
+{
+  return _frameBytes;
+}
+
+
+const uint8_t* Base::getIconRle(WeatherIcon icon) {
+  switch (icon) {
+    case ICON_CLEAR_DAY:            return wIco_clear_day_rle;
+    case ICON_CLEAR_NIGHT:          return wIco_clear_night_rle;
+    case ICON_RAIN:                 return wIco_rain_rle;
+    case ICON_SNOW:                 return wIco_snow_rle;
+    case ICON_SLEET:                return wIco_sleet_rle;
+    case ICON_WIND:                 return wIco_wind_rle;
+    case ICON_FOG:                  return wIco_fog_rle;
+    case ICON_CLOUDY:               return wIco_cloudy_rle;
+    case ICON_PARTLY_CLOUDY_DAY:    return wIco_partly_cloudy_day_rle;
+    case ICON_PARTLY_CLOUDY_NIGHT:  return wIco_partly_cloudy_night_rle;
+    case ICON_HAIL:                 return wIco_hail_rle;
+    case ICON_THUNDERSTORM:         return wIco_thunderstorm_rle;  
+    default:                        return wIco_partly_cloudy_day_rle;
+  }
 }
 
 
 
-Clock::Clock(Base * _b): B(_b) 
+Clock::Clock(Base * _b): Base(_b->getDisplay(), _b->getTouch()), B(_b) 
 {
+  _screen = _b;
   setReDrawFlag();
 }
 
@@ -124,43 +333,58 @@ void Clock::setReDrawFlag()
 }
 
 void Clock::Draw()
+{
+  if (_reDraw) markDirty(_xleft, _ytop, 96, 30);
+  if (_ch) markDirty(_xleft, _ytop, 32, 30);
+  if (_cm) markDirty(_xleft+32, _ytop, 32, 30);
+  if (_cs)
+  {
+    // Seconds and the blinking colons
+    markDirty(_xleft+64, _ytop, 32, 30);
+    markDirty(_xleft+28, _ytop, 8, 30);
+    markDirty(_xleft+60, _ytop, 8, 30);
+  }
+  flush();
+
+  _reDraw = false;
+}
+
+void Clock::Render()
 {
   // digital clock display of the time
   _Disp->setTextColor(TFT_WHITE);
   _Disp->setFreeFont(&FreeSans12pt7b);  
   
-  if (_ch || _reDraw)
+  if (isDirty(_xleft, _ytop, 32, 30))
   {
     String sh = String(_time.hh);
     if (sh.length() == 1) sh = "0" + sh;
-    _Disp->fillRect(_xleft, _ytop, 32, 30, TFT_BLACK);
     _Disp->drawCentreString(sh, _xleft+16, _ytop, 1);
   }
-  if (_cm || _reDraw)
+  if (isDirty(_xleft+32, _ytop, 32, 30))
   {
     String sm = String(_time.mm);
     if (sm.length() == 1) sm = "0" + sm;
-    _Disp->fillRect(_xleft+32, _ytop, 32, 30, TFT_BLACK);
     _Disp->drawCentreString(sm, _xleft+48, _ytop, 1);
   }
-  if (_cs || _reDraw)
+  if (isDirty(_xleft+64, _ytop, 32, 30))
   {
     String ss = String(_time.ss);
     if (ss.length() == 1) ss = "0" + ss;
-    _Disp->fillRect(_xleft+64, _ytop, 32, 30, TFT_BLACK);
     _Disp->drawCentreString(ss, _xleft+80, _ytop, 1);
   }      
   
-  if (_time.ss % 2) _Disp->setTextColor(TFT_BLACK);
-  _Disp->drawCentreString(":", _xleft+32, _ytop, 1);
-  _Disp->drawCentreString(":", _xleft+64, _ytop, 1);
-
-  _reDraw = false;
+  if (_time.ss % 2 == 0)
+  {
+    _Disp->drawCentreString(":", _xleft+32, _ytop, 1);
+    _Disp->drawCentreString(":", _xleft+64, _ytop, 1);
+  }
 }
 
 
-BusScreen::BusScreen(Base * _b): B(_b) 
+BusScreen::BusScreen(Base * _b): Base(_b->getDisplay(), _b->getTouch()), _header(_b->getDisplay(), HEADER_LIST_BYTES), B(_b)
 {
+  _screen = _b;
   setReDrawFlag();
 }
 
@@ -169,39 +393,89 @@ void BusScreen::updateBusStop(KVGbusStop newStop)
   _newStop = newStop;
 }
 
+/**
+  Departures that were not read since the start show the stop name in grey.
+*/
+void BusScreen::setStale(bool stale)
+{
+  if (stale != _stale) markDirty(0, 0, Clock::_xleft-1, Y_HEAD-1);
+  _stale = stale;
+}
+
 void BusScreen::setReDrawFlag()
 {
   _reDraw = true;
 }
 
-void BusScreen::DrawHeader()
+/**
+  The table header never changes, it is recorded once and replayed by Render().
+*/
+void BusScreen::RecordHeader()
 {
-  _Disp->fillRect(0, Y_HEAD, 320, 24, TFT_BLACK);
+  _header.begin();
   _Disp->setTextColor(TFT_WHITE);
-  _Disp->drawString("Linie", 6, Y_HEAD, 2);
-  _Disp->drawFastVLine(0, Y_HEAD, 24, TFT_WHITE);
-  _Disp->drawString("Richtung", 50, Y_HEAD, 2);
-  _Disp->drawFastVLine(44, Y_HEAD, 24, TFT_WHITE);
-  _Disp->drawString("Abfahrt", 250, Y_HEAD, 2);
-  _Disp->drawFastVLine(244, Y_HEAD, 24, TFT_WHITE);
+  _Disp->setTextDatum(TL_DATUM);
+  _header.drawString("Linie", 6, Y_HEAD, 2);
+  _header.drawFastVLine(0, Y_HEAD, 24, TFT_WHITE);
+  _header.drawString("Richtung", 50, Y_HEAD, 2);
+  _header.drawFastVLine(44, Y_HEAD, 24, TFT_WHITE);
+  _header.drawString("Abfahrt", 250, Y_HEAD, 2);
+  _header.drawFastVLine(244, Y_HEAD, 24, TFT_WHITE);
 }
 
 void BusScreen::Draw()
 {
-  if (_reDraw) DrawHeader();
-  
   _newStop.stopName.replace("ß","ss");
-  // Overvwrite bus number if there are any changes
-  if (_newStop.stopName != _busStop.stopName || _reDraw)
+
+  if (_reDraw)
+  {
+    if (_header.length() == 0) RecordHeader();
+    markDirty(0, 0, Clock::_xleft-1, Y_HEAD-1);
+    markDirty(0, Y_HEAD, 320, 24);
+    markDirty(0, Y_LIST, 320, 6*ROW_HEIGHT);
+  }
+
+  // Mark the fields that changed
+  if (_newStop.stopName != _busStop.stopName)
+    markDirty(0, 0, Clock::_xleft-1, Y_HEAD-1);
+
+  for (int row=0; row < 6; row++)
   {
-      _Disp->setTextColor(TFT_WHITE);
+    KVGbus &bus = _busStop.departures[row];
+    KVGbus &newBus = _newStop.departures[row];
+    int ypos = row * ROW_HEIGHT + Y_LIST;
+
+    if (newBus.number != bus.number)
+    {
+      markDirty(0, ypos, 44, ROW_HEIGHT);
+      // Departure time and separation line are only shown for a line number
+      markDirty(244, ypos, 320-244, ROW_HEIGHT);
+      if (row > 0) markDirty(0, ypos-8, 320, 1);
+    }
+    if (newBus.dir != bus.dir)
+      markDirty(44, ypos, 244-44, ROW_HEIGHT);
+    if ((newBus.depMinutes != bus.depMinutes) || (newBus.depTime != bus.depTime) || (newBus.depDelay != bus.depDelay))
+      markDirty(244, ypos, 320-244, ROW_HEIGHT);
+  }
+  _busStop = _newStop;
+
+  flush();
+
+  _reDraw = false;
+}
+
+void BusScreen::Render()
+{
+  if (isDirty(0, Y_HEAD, 320, 24)) _header.draw(_Disp);
+  
+  if (isDirty(0, 0, Clock::_xleft-1, Y_HEAD-1))
+  {
+      _Disp->setTextColor(_stale ? TFT_LIGHTGREY : TFT_WHITE);
       _Disp->setFreeFont(&FreeSans12pt7b);  
-      _Disp->fillRect(0, 0, Clock::_xleft-1, Y_HEAD-1, TFT_BLACK);
-      _busStop.stopName = _newStop.stopName;
+      _Disp->setTextDatum(TL_DATUM);
       _Disp->drawString(_busStop.stopName, 0, 4, 1);
   }
 
-  
   _Disp->setTextColor(TFT_ORANGE);
   _Disp->setFreeFont(&FreeMonoBold9pt7b);
   uint16_t ypos = 0;
@@ -211,43 +485,23 @@ void BusScreen::Draw()
     ypos = row * ROW_HEIGHT + Y_LIST;
     _Disp->setTextDatum(TL_DATUM);
 
-    // Overvwrite bus number if there are any changes
-    if ((_newStop.departures[row].number != _busStop.departures[row].number) || _reDraw)
-    {
-        _Disp->fillRect(0, ypos, 44, ROW_HEIGHT, TFT_BLACK);
-        _busStop.departures[row].number = _newStop.departures[row].number;
-        if (_busStop.departures[row].number.length() != 0)
-          _Disp->drawCentreString(_busStop.departures[row].number, 20, ypos, 1);
-    }
-
-    // Overvwrite bus destination if there are any changes
-    if ((_newStop.departures[row].dir != _busStop.departures[row].dir) || _reDraw)
-    {
-        _Disp->fillRect(44, ypos, 244-44, ROW_HEIGHT, TFT_BLACK);
-        _busStop.departures[row].dir = _newStop.departures[row].dir;
-        if (_busStop.departures[row].dir.length() != 0)
-          _Disp->drawString(_busStop.departures[row].dir, 50, ypos, 1);
-    }
+    // Bus number
+    if (isDirty(0, ypos, 44, ROW_HEIGHT) && (_busStop.departures[row].number.length() != 0))
+        _Disp->drawCentreString(_busStop.departures[row].number, 20, ypos, 1);
 
+    // Bus destination
+    if (isDirty(44, ypos, 244-44, ROW_HEIGHT) && (_busStop.departures[row].dir.length() != 0))
+        _Disp->drawString(_busStop.departures[row].dir, 50, ypos, 1);
 
-    // Overvwrite departure time if there are any changes
-    if ((_newStop.departures[row].depMinutes != _busStop.departures[row].depMinutes) || (_newStop.departures[row].depTime != _busStop.departures[row].depTime) || _reDraw)
+    // Departure time
+    if (isDirty(244, ypos, 320-244, ROW_HEIGHT))
     {
-        _Disp->fillRect(244, ypos, 320-244, ROW_HEIGHT, TFT_BLACK);
-        _busStop.departures[row].depTime    = _newStop.departures[row].depTime;
-        _busStop.departures[row].depMinutes = _newStop.departures[row].depMinutes;
-        _busStop.departures[row].depDelay   = _newStop.departures[row].depDelay;
         if ((_busStop.departures[row].depMinutes >= -1) && (_busStop.departures[row].number.length() != 0))
         {
           String minStr = String(_busStop.departures[row].depMinutes);
-          //char buf[4],bufMin[4],bufDelay[5];
-          //itoa(_busStop.departures[row].depMinutes, bufMin, 10);
           if (_busStop.departures[row].depDelay != 0)
           {
             String delStr = "+" + String(_busStop.departures[row].depDelay);
-            //itoa(actualStop.departures[row].depDelay, buf, 10);
-            //strcpy(bufDelay,"+");
-            //strcat(bufDelay, buf);
             _Disp->setTextFont(0);        // Select font 0 which is the Adafruit font
             _Disp->setTextColor(TFT_RED);
             _Disp->setTextDatum(TL_DATUM);
@@ -266,19 +520,96 @@ void BusScreen::Draw()
     }
 
     // Draw separation lines
-    if ((_busStop.departures[row].number.length() != 0) && (row > 0))
+    if ((_busStop.departures[row].number.length() != 0) && (row > 0) && isDirty(0, ypos-8, 320, 1))
       _Disp->drawFastHLine(0,ypos-8,360,TFT_GREY);
   }
+}
 
-  _reDraw = false;
+
+GraphModel::GraphModel(int16_t x, int16_t y, int16_t w, int16_t h): x(x), y(y), w(w), h(h), dx(w/47)
+{
+  scale = (GraphScale) {0, 1, 1, 1};
+  for (int i=0; i<48; i++) rows[i] = y + h;
+}
+
+/**
+  Screen row of a value. Parts of a row are rounded up as when the graphs were
+  drawn with float math, the scale always covers the samples.
+*/
+int16_t GraphModel::row(int16_t value)
+{
+  int32_t range = scale.ymax - scale.ymin;
+  return y + h - ((int32_t)(value - scale.ymin) * h + range - 1) / range;
+}
+
+void GraphModel::setData(const int16_t data[], GraphScale s)
+{
+  scale = s;
+  for (int i=0; i<48; i++) rows[i] = row(data[i]);
+}
+
+void GraphModel::setData(const uint8_t data[], GraphScale s)
+{
+  scale = s;
+  for (int i=0; i<48; i++) rows[i] = row(data[i]);
 }
 
 
-WeatherScreen::WeatherScreen(Base * _b): B(_b){}
+WeatherScreen::WeatherScreen(Base * _b): Base(_b->getDisplay(), _b->getTouch()),
+  _tempBG(_b->getDisplay(), GRAPH_LIST_BYTES), _rainBG(_b->getDisplay(), GRAPH_LIST_BYTES),
+  _windBG(_b->getDisplay(), GRAPH_LIST_BYTES), _newBG(_b->getDisplay(), GRAPH_LIST_BYTES),
+  _temp(128, 6, 188, 100), _rain(128, 116, 188, 50), _rainProb(128, 116, 188, 50), _wind(128, 176, 188, 50),
+  B(_b)
+{
+  _screen = _b;
+  _bgColor = TFT_CBLUE;
+  setReDrawFlag();
+}
+
+/**
+  Keeps a reference to the forecast, it is updated in place by DarkSkyAPI.
+*/
+void WeatherScreen::updateWeather(const WeatherForecast &newWeather)
+{
+  _actualWeather = &newWeather;
+
+  // Mark the screen parts showing changed values, graphs include their axis labels
+  if (newWeather.changed & WEATHER_CHANGED_ICON)
+    markDirty(20, 40, 80, 80);
+  if (newWeather.changed & WEATHER_CHANGED_TEMP)
+    markDirty(0, 134, 110, 40);
+  if (newWeather.changed & WEATHER_CHANGED_FTEMP)
+    markDirty(104, 0, 216, 112);
+  if (newWeather.changed & WEATHER_CHANGED_RAIN)
+    markDirty(104, 112, 216, 60);
+  if (newWeather.changed & WEATHER_CHANGED_WIND)
+    markDirty(104, 172, 216, 68);
+  if (newWeather.changed & (WEATHER_CHANGED_FTEMP | WEATHER_CHANGED_RAIN | WEATHER_CHANGED_WIND))
+    _rescale = true;
+
+  // Only changed series are scaled and projected again
+  if (newWeather.changed & WEATHER_CHANGED_FTEMP)
+    _temp.setData(newWeather.fTemp, TempScale(newWeather.fTemp));
+  if (newWeather.changed & WEATHER_CHANGED_RAIN)
+  {
+    _rain.setData(newWeather.fRainInt, RainScale(newWeather.fRainInt));
+    _rainProb.setData(newWeather.fRainProb, (GraphScale) {0, 100, 10, 1});
+  }
+  if (newWeather.changed & WEATHER_CHANGED_WIND)
+  {
+    _wind.setData(newWeather.fWindSpd, WindScale(newWeather.fWindSpd));
+    for (int i=0; i<WIND_ARROWS; i++)
+      SetWindArrow(_arrows[i], newWeather.fWindDir[3*i], 6);
+  }
+}
 
-void WeatherScreen::updateWeather(WeatherForecast newWeather)
+/**
+  A forecast that was not read since the start shows the temperature in grey.
+*/
+void WeatherScreen::setStale(bool stale)
 {
-  _actualWeather = newWeather;
+  if (stale != _stale) markDirty(0, 134, 110, 40);
+  _stale = stale;
 }
 
 void WeatherScreen::setReDrawFlag()
@@ -286,38 +617,53 @@ void WeatherScreen::setReDrawFlag()
   _reDraw = true;
 }
 
-void WeatherScreen::DrawGraphBG(int x,int y,int w,int h, float ymin, float ymax, float ystep, String description, bool showXscale = true)
+/**
+  Records the background of a graph into _newBG. The current hour is marked,
+  so the graph is recorded again every hour.
+*/
+void WeatherScreen::RecordGraphBG(GraphModel &g, const char *description, bool showXscale = true)
 {
-  int i,x1,deltax,yt,lines,tempy;
-  
-  deltax = w/47;  
+  _newBG.begin();
+  GraphBG(_newBG, g, description, showXscale);
+}
 
+/**
+  Background of a graph: grid, caption and scales. Canvas is the display list
+  that records it, or the display if the recording did not fit.
+*/
+template <class Canvas> void WeatherScreen::GraphBG(Canvas &l, GraphModel &g, const char *description, bool showXscale)
+{
+  int i,x1,yt,lines,tempy;
+  int x = g.x, y = g.y, w = g.w, h = g.h, deltax = g.dx;
+  GraphScale s = g.scale;
+  char label[8];
+  
   // Graph background
-  _Disp->fillRect(x, y, w, h, TFT_WHITE);
-  _Disp->drawRect(x, y, w, h, TFT_LIGHTGREY);
+  l.fillRect(x, y, w, h, TFT_WHITE);
+  l.drawRect(x, y, w, h, TFT_LIGHTGREY);
 
   // Graph caption
   _Disp->setTextDatum(TR_DATUM);
   _Disp->setTextFont(0);
   _Disp->setTextColor(TFT_DARKGREY);
-  _Disp->drawString(description, x+w-2, y+2);
+  l.drawString(description, x+w-2, y+2);
 
   
   // Y-scale minimum and maximum
   _Disp->setTextDatum(CR_DATUM);
   _Disp->setTextFont(0);
   _Disp->setTextColor(TFT_WHITE);
-  _Disp->drawString(String((int)ymax), x-2, y);
-  _Disp->drawString(String((int)ymin), x-2, y+h);
+  l.drawString(itoa(s.ymax / s.unit, label, 10), x-2, y);
+  l.drawString(itoa(s.ymin / s.unit, label, 10), x-2, y+h);
 
   // Rest of Y-scale and horizontal lines
-  lines = (ymax-ymin)/ystep;  
-  tempy = (ystep/(ymax-ymin)) * h;
+  lines = (s.ymax - s.ymin) / s.ystep;  
+  tempy = s.ystep * h / (s.ymax - s.ymin);
   for (i=1; i<lines; i++)
   {
     yt = y+h-i*tempy;
-    _Disp->drawFastHLine(x,yt,w,TFT_LIGHTGREY);
-    _Disp->drawString(String((int)(i*ystep+ymin)), x-2, yt);
+    l.drawFastHLine(x,yt,w,TFT_LIGHTGREY);
+    l.drawString(itoa((i * s.ystep + s.ymin) / s.unit, label, 10), x-2, yt);
   }
 
   x1 = x;
@@ -328,216 +674,233 @@ void WeatherScreen::DrawGraphBG(int x,int y,int w,int h, float ymin, float ymax,
     // Vertical lines every 12 hours 
     if (i % 12 == 0)
     {
-      _Disp->drawFastVLine(x1,y,h,TFT_LIGHTGREY);
+      l.drawFastVLine(x1,y,h,TFT_LIGHTGREY);
       // Thicker line at midnight of second day
-      if (i == 24) {_Disp->drawFastVLine(x1-1,y,h,TFT_CBLUE);_Disp->drawFastVLine(x1,y,h,TFT_CBLUE);}
+      if (i == 24) {l.drawFastVLine(x1-1,y,h,TFT_CBLUE);l.drawFastVLine(x1,y,h,TFT_CBLUE);}
     }
     // X-scale every 6 hours
     if (i % 6 == 0 && showXscale)
     {
-      if (i < 23) {_Disp->drawString(String(i), x1+1, y+h+4);}
-      else        {_Disp->drawString(String(i-24), x1+1, y+h+4);}
-    }
-    // Green line at current hour
-    if (i == hour())
-    {
-      _Disp->drawFastVLine(x1,y,h,TFT_GREEN);
-      _Disp->drawFastVLine(x1+1,y,h,TFT_GREEN);
+      l.drawString(itoa((i < 23) ? i : i-24, label, 10), x1+1, y+h+4);
     }
       
     x1 = x1 + deltax;
   }  
   // X-scale at begin and end
-  if (showXscale) _Disp->drawString("0", x, y+h+4);
-  if (showXscale) _Disp->drawString("0", x+w, y+h+4);
+  if (showXscale) l.drawString("0", x, y+h+4);
+  if (showXscale) l.drawString("0", x+w, y+h+4);
+
+  // Green line at current hour, recorded last so that only this entry differs
+  // from the recording of the hour before. Hour i is at x + (i-1)*deltax like
+  // the lines and labels above.
+  if (hour() > 0)
+  {
+    x1 = x + (hour() - 1) * deltax;
+    l.drawFastVLine(x1,y,h,TFT_GREEN);
+    l.drawFastVLine(x1+1,y,h,TFT_GREEN);
+  }
   
   _Disp->setTextDatum(TL_DATUM);
 }
 
 
-void WeatherScreen::DrawTempGraph(int x,int y,int w,int h, float arr[])
+/**
+  Records the graph backgrounds for the current hour and forecast. Only the
+  parts that look different from the last recording are marked for redrawing.
+*/
+void WeatherScreen::RecordGraphs()
 {
-  
-  int i,l = sizeof(arr);
-  float ymin=arr[0], ymax=arr[0], limLow, limHigh;
+  if (_actualWeather == NULL) return;
+
+  RecordGraphBG(_temp, GRAPH_CAPTION_TEMP, false);
+  UpdateGraphBG(_tempBG, _tempDirect, 104, 0, 216, 112);
+  RecordGraphBG(_rain, GRAPH_CAPTION_RAIN, false);
+  UpdateGraphBG(_rainBG, _rainDirect, 104, 112, 216, 60);
+  RecordGraphBG(_wind, GRAPH_CAPTION_WIND, true);
+  UpdateGraphBG(_windBG, _windDirect, 104, 172, 216, 68);
+}
 
-  for (i=0; i<48; i++)
+/**
+  Takes the recording of _newBG for a graph. A recording that did not fit is
+  incomplete and not taken, the graph is drawn directly and its whole area
+  is marked. So is the area after such a recording, the list holds an older
+  background.
+*/
+void WeatherScreen::UpdateGraphBG(TFT_eDisplayList &list, bool &direct, int x,int y,int w,int h)
+{
+  int16_t dx, dy, dw, dh;
+
+  if (_newBG.overflow() || direct)
   {
-    if (arr[i] < ymin) ymin = arr[i];
-    if (arr[i] > ymax) ymax = arr[i];    
+    if (DEBUG_Display && _newBG.overflow()) Serial.println("Graph background: list full");
+    markDirty(x, y, w, h);
   }
-  limLow = 5 * ((int)ymin / 5);
-  if (ymin < 0) limLow -= 5;
-  limHigh = 5 * ((int)ymax / 5)+5;
-  if (ymax < 0) limHigh -= 5;
+  else if (_newBG.diff(list, dx, dy, dw, dh))
+    markDirty(dx, dy, dw, dh);
 
-  DrawGraphBG(x, y, w, h, limLow, limHigh, 5, "Temperatur",false);
-  
-  int x1, y1, x2, y2;
-  float tempy;
-  int deltax = w/47;  
-  x1 = x;
-  tempy = ((arr[0]-limLow)/(limHigh-limLow)) * h;
-  y1 = y + h - tempy;
- 
-  for (int i=1; i<48; i++)
-  {
-    x2 = x1 + deltax;
-    tempy = ((arr[i]-limLow)/(limHigh-limLow)) * h;
-    y2 = y + h - tempy;  
-      
-    _Disp->drawLine(x1, y1+1, x2, y2+1, TFT_BLACK);
-    _Disp->drawLine(x1, y1, x2, y2, TFT_BLACK);
-    _Disp->drawLine(x1, y1-1, x2, y2-1, TFT_BLACK);
-      
-    x1 = x2;
-    y1 = y2;
-  }  
+  direct = _newBG.overflow();
+  if (!direct) list.swap(_newBG);
 }
-void WeatherScreen::DrawRainGraph(int x,int y,int w,int h, float rInt[], float rProb[])
+
+/**
+  Replays the background of a graph, or draws it if it did not fit the list.
+*/
+void WeatherScreen::DrawGraphBG(TFT_eDisplayList &list, bool direct, GraphModel &g, const char *description, bool showXscale)
 {
-  
-  int i;
-  float ymin=0, ymax=0;
+  if (direct) GraphBG(*_Disp, g, description, showXscale);
+  else list.draw(_Disp);
+}
 
-  for (i=0; i<48; i++)
-  {
-    if (rInt[i] > ymax) ymax = rInt[i];    
-  }
-  ymax = (int)ymax +1;
+/**
+  The scales are in the units of WeatherForecast, so no sample is converted.
+  Temperatures get a range of whole 5 °C steps around the forecast.
+*/
+GraphScale WeatherScreen::TempScale(const int16_t arr[])
+{
+  int16_t ymin=arr[0], ymax=arr[0], limLow, limHigh;
 
-  DrawGraphBG(x, y, w, h, ymin, ymax, 1, "Regen (mm/h)", false);
-  
-  int x1, y1;
-  float tempy;
-  int deltax = w/47;  
-  x1 = x;
- 
   for (int i=0; i<48; i++)
   {
-    tempy = ((rInt[i]-ymin)/(ymax-ymin)) * h;
-    y1 = y + h - tempy;  
-     //Serial.println("Liniev" + String(x1) + "," + String(y1) + "," + String(y) + "," + String(rInt[i]));
-    _Disp->drawFastVLine(x1, y1, y+h-y1, TFT_BLUE);
-    _Disp->drawFastVLine(x1+1, y1, y+h-y1, TFT_BLUE);
-      
-    x1 = x1 + deltax;
+    if (arr[i] < ymin) ymin = arr[i];
+    if (arr[i] > ymax) ymax = arr[i];    
   }
+  limLow = 50 * (ymin / 50);
+  if (ymin < 0) limLow -= 50;
+  limHigh = 50 * (ymax / 50) + 50;
+  if (ymax < 0) limHigh -= 50;
 
-  int x2, y2;
-  ymax = 100; ymin = 0;
-  x1 = x;
-  tempy = ((rProb[0]-ymin)/(ymax-ymin)) * h;
-  y1 = y + h - tempy;
- 
-  for (int i=1; i<48; i++)
+  return (GraphScale) {limLow, limHigh, 50, 10};
+}
+
+GraphScale WeatherScreen::RainScale(const uint8_t rInt[])
+{
+  int16_t ymax=0;
+
+  for (int i=0; i<48; i++)
   {
-    x2 = x1 + deltax;
-    tempy = ((rProb[i]-ymin)/(ymax-ymin)) * h;
-    y2 = y + h - tempy;  
-      
-    _Disp->drawLine(x1, y1, x2, y2, TFT_BLACK);
-      
-    x1 = x2;
-    y1 = y2;
-  }  
+    if (rInt[i] > ymax) ymax = rInt[i];    
+  }
+  return (GraphScale) {0, (int16_t)(10 * (ymax / 10) + 10), 10, 10};
 }
 
-void WeatherScreen::DrawWindGraph(int x,int y,int w,int h, int wDir[], int wSpd[])
+GraphScale WeatherScreen::WindScale(const uint8_t wSpd[])
 {
-  
-  int i;
-  int x1, y1, x2, y2;
-  float tempy;
-  int deltax = w/47; 
-  float ymin=0, ymax=0;
+  int16_t ymax=0;
 
-  for (i=0; i<48; i++)
+  for (int i=0; i<48; i++)
   {
     if (wSpd[i] > ymax) ymax = wSpd[i];    
   }
-  ymax = 5 * ((int)ymax / 5)+5;
+  return (GraphScale) {0, (int16_t)(5 * (ymax / 5) + 5), 10, 1};
+}
 
-  DrawGraphBG(x, y, w, h, ymin, ymax, 10, "Wind (km/h)");
+void WeatherScreen::DrawTempGraph()
+{
+  DrawGraphBG(_tempBG, _tempDirect, _temp, GRAPH_CAPTION_TEMP, false);
+  _Disp->drawPolyline(_temp.x, _temp.dx, _temp.rows, 48, 3, TFT_BLACK);
+}
 
-  x1 = x;
-  tempy = ((wSpd[0]-ymin)/(ymax-ymin)) * h;
-  y1 = y + h - tempy;
- 
-  for (int i=1; i<48; i++)
-  {
-    x2 = x1 + deltax;
-    tempy = ((wSpd[i]-ymin)/(ymax-ymin)) * h;
-    y2 = y + h - tempy;  
-    float dy = (y1 - y2)/deltax;
-    for (int j=0;j<deltax;j++)
-      _Disp->drawFastVLine(x1+j, y1-dy*j, y+h-y1+dy*j, TFT_LIGHTGREY);
-      
-    x1 = x2;
-    y1 = y2;
-  }  
+void WeatherScreen::DrawRainGraph()
+{
+  DrawGraphBG(_rainBG, _rainDirect, _rain, GRAPH_CAPTION_RAIN, false);
+  _Disp->drawBars(_rain.x, _rain.dx, _rain.rows, 48, 2, _rain.y + _rain.h, TFT_BLUE);
+  _Disp->drawPolyline(_rainProb.x, _rainProb.dx, _rainProb.rows, 48, 1, TFT_BLACK);
+}
+
+void WeatherScreen::DrawWindGraph()
+{
+  int x1, y1;
+
+  DrawGraphBG(_windBG, _windDirect, _wind, GRAPH_CAPTION_WIND, true);
+  _Disp->fillAreaUnderCurve(_wind.x, _wind.dx, _wind.rows, 48, _wind.y + _wind.h, TFT_LIGHTGREY);
    
-  x1 = x;
-  y1 = y+h/2;
+  x1 = _wind.x;
+  y1 = _wind.y + _wind.h/2;
  
   for (int i=1; i<48; i++)
   {
     if (i % 3 == 0)
-      DrawWindArrow(x1, y1, 6, wDir[i], TFT_BLACK);
+      DrawWindArrow(x1, y1, _arrows[i/3], TFT_BLACK);
       
-    x1 = x1 + deltax;
+    x1 = x1 + _wind.dx;
   }
 }
 
-void WeatherScreen::DrawWindArrow(int x, int y, float rad, int dir, uint32_t color)
+/**
+  Computes the offsets of an arrow pointing to where the wind blows. The
+  direction is the DarkSky bearing in 256 steps, so it indexes the sine table
+  directly. The arrows are set by updateWeather() and reused for every band
+  and redraw until the wind forecast changes.
+*/
+void WeatherScreen::SetWindArrow(WindArrow &arrow, uint8_t dir, int rad)
 {
-  float dx,dy,dxArr,dyArr;
-  float theta;
+  uint8_t theta = dir + 128;
+  arrow.tipX = mulQ15(rad, sinQ15(theta));
+  arrow.tipY = -mulQ15(rad, cosQ15(theta));
 
-  theta = (dir-180) * PI/ 180;
-  dx = sin(theta)*rad;
-  dy = cos(theta)*rad;
+  theta = dir + 64;
+  arrow.leftX = -mulQ15(rad, sinQ15(theta) / 3);
+  arrow.leftY = mulQ15(rad, cosQ15(theta) / 3);
 
-  _Disp->drawLine(x-dx, y+dy, x+dx, y-dy, color);
+  theta = dir + 192;
+  arrow.rightX = -mulQ15(rad, sinQ15(theta) / 3);
+  arrow.rightY = mulQ15(rad, cosQ15(theta) / 3);
+}
 
-  theta = (dir+180-90) * PI/ 180;
-  dxArr = sin(theta)*rad/3;
-  dyArr = cos(theta)*rad/3;
-  _Disp->drawLine(x+dx, y-dy, x-dxArr,y+dyArr,color);
-  
-  theta = (dir+180+90) * PI/ 180;
-  dxArr = sin(theta)*rad/3;
-  dyArr = cos(theta)*rad/3;
-  _Disp->drawLine(x+dx, y-dy, x-dxArr,y+dyArr,color);
-  
+void WeatherScreen::DrawWindArrow(int x, int y, const WindArrow &arrow, uint32_t color)
+{
+  int tipX = x + arrow.tipX, tipY = y + arrow.tipY;
+
+  _Disp->drawLine(x - arrow.tipX, y - arrow.tipY, tipX, tipY, color);
+  _Disp->drawLine(tipX, tipY, x + arrow.leftX, y + arrow.leftY, color);
+  _Disp->drawLine(tipX, tipY, x + arrow.rightX, y + arrow.rightY, color);
 }
 
 
 void WeatherScreen::Draw()
 {
-  _Disp->fillScreen(TFT_CBLUE);
-  //_Disp->fillRect(0,0,110,240,TFT_BLACK);
-  
-  B->drawWeatherIcon(20, 40, _actualWeather.actIco, TFT_WHITE);
-     
-  _Disp->setFreeFont(&FreeSansBold9pt7b);   
-  _Disp->setTextColor(TFT_WHITE); 
-  _Disp->setTextDatum(TL_DATUM);
-  int tX = 82, tY = 140;
-  _Disp->drawString(" C", tX+6, tY, 1); 
-  _Disp->drawCircle(tX+7, tY+3, 2, TFT_WHITE);        
-  _Disp->setTextDatum(TR_DATUM);
-  _Disp->setFreeFont(&FreeSansBold18pt7b); 
-  _Disp->drawString(String(_actualWeather.actTemp,1), tX, tY, 1);
-  _Disp->setTextDatum(TL_DATUM);
-  
-      
-      
-  DrawTempGraph(128,6,188,100,_actualWeather.fTemp);
-  DrawRainGraph(128,116,188,50,_actualWeather.fRainInt,_actualWeather.fRainProb);
-  DrawWindGraph(128,176,188,50,_actualWeather.fWindDir,_actualWeather.fWindSpd);
+  if (_reDraw) markDirty(0, 0, 320, 240);
+
+  // The graphs mark the current hour and are scaled to the forecast
+  if ((hour() != _hour) || _rescale)
+  {
+    _hour = hour();
+    _rescale = false;
+    RecordGraphs();
+  }
 
+  flush();
 
   _reDraw = false;
 }
 
+void WeatherScreen::Render()
+{
+  if (_actualWeather == NULL) return;
+  
+  if (isDirty(20, 40, 80, 80))
+    drawWeatherIcon(20, 40, _actualWeather->actIco, TFT_WHITE);
+     
+  if (isDirty(0, 134, 110, 40))
+  {
+    uint16_t color = _stale ? TFT_LIGHTGREY : TFT_WHITE;
+    _Disp->setFreeFont(&FreeSansBold9pt7b);   
+    _Disp->setTextColor(color); 
+    _Disp->setTextDatum(TL_DATUM);
+    int tX = 82, tY = 140;
+    _Disp->drawString(" C", tX+6, tY, 1); 
+    _Disp->drawCircle(tX+7, tY+3, 2, color);        
+    _Disp->setTextDatum(TR_DATUM);
+    _Disp->setFreeFont(&FreeSansBold18pt7b); 
+    _Disp->drawString(String(_actualWeather->actTemp / 10.0, 1), tX, tY, 1);
+    _Disp->setTextDatum(TL_DATUM);
+  }
+      
+  if (isDirty(104, 0, 216, 112))
+    DrawTempGraph();
+  if (isDirty(104, 112, 216, 60))
+    DrawRainGraph();
+  if (isDirty(104, 172, 216, 68))
+    DrawWindGraph();
+}
+
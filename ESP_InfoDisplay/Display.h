@@ -12,6 +12,17 @@
 
 #define TFT_CBLUE   0x04FB      /* 0, 159, 218 */
 
+#define DEBUG_Display 0
+
+#define DIRTY_RECTS_MAX      8        // Damaged areas tracked per screen element
+#define DIRTY_BUFFER_PIXELS  4800     // RAM for flushing a damaged area (2 bytes per pixel)
+#define HEADER_LIST_BYTES    160      // Recorded table header of the bus screen
+#define GRAPH_LIST_BYTES     768      // Recorded background of one weather graph
+#define GRAPH_CAPTION_TEMP   "Temperatur"
+#define GRAPH_CAPTION_RAIN   "Regen (mm/h)"
+#define GRAPH_CAPTION_WIND   "Wind (km/h)"
+#define TRANSITION_LAYERS    4        // Screen elements composed by a transition
+
 #include "Arduino.h"
 #include <String.h>
 #include <TimeLib.h>
@@ -25,11 +36,19 @@
 // DarkSky interface
 #include "DarkSkyAPI.h"
 // Display classes
-#include "icons.h"
+#include "icons_rle.h"
 
 
 typedef struct TimeOfDay {uint8_t hh;  uint8_t mm;  uint8_t ss;};
 
+typedef struct DirtyRect {int16_t x;  int16_t y;  int16_t w;  int16_t h;};
+
+// Value range of a graph in data units, e.g. 0.1 °C, the labels show value / unit
+typedef struct GraphScale {int16_t ymin;  int16_t ymax;  int16_t ystep;  int16_t unit;};
+
+// Wind arrow as offsets from its centre, the tail is opposite to the tip
+typedef struct WindArrow {int8_t tipX;  int8_t tipY;  int8_t leftX;  int8_t leftY;  int8_t rightX;  int8_t rightY;};
+
 class Base
 {
   public:
@@ -39,15 +58,34 @@ class Base
     XPT2046 * getTouch();
     void initDispAndTouch();
     void clearScreen();
-    void drawXbm(int x, int y, int width, int height, const char *xbm, uint32_t color);
-    void drawCenterXbm(int width, int height, const char *xbm, uint32_t color);
-    void drawLogoSpinner(int count, const char *logo, int lw, int lh);
-    void drawWeatherIcon(int x, int y, String weatherIcon, uint32_t color);
+    void drawRle(int x, int y, int width, int height, const uint8_t *rle, uint32_t color);
+    void drawRle(int x, int y, int width, int height, const uint8_t *rle, uint32_t color, uint32_t bgColor);
+    void drawCenterRle(int width, int height, const uint8_t *rle, uint32_t color);
+    void drawLogoSpinner(int count, const uint8_t *logo, int lw, int lh);
+    void drawWeatherIcon(int x, int y, WeatherIcon weatherIcon, uint32_t color);
+    void markDirty(int x, int y, int w, int h);
+    bool isDirty(int x, int y, int w, int h);
+    void flush();
+    uint32_t lastFrameBytes();
+    void beginTransition();
+    void endTransition();
 
   private:  
-    const char* getIconFromString(String icon);
+    const uint8_t* getIconRle(WeatherIcon icon);
+    void addLayer(Base *layer);
+    void renderBand(TFT_eSPI *spr, DirtyRect band);
+    DirtyRect _dirty[DIRTY_RECTS_MAX];
+    uint8_t _nDirty = 0;
+    DirtyRect _clip = {0, 0, 0x7FFF, 0x7FFF};
+    uint32_t _frameBytes = 0;
+    Base *_layers[TRANSITION_LAYERS];
+    uint8_t _nLayers = 0;
+    bool _transition = false;
 
   protected:
+    virtual void Render() {}
+    Base *_screen = this;   // Base composing the transitions of this element
+    uint32_t _bgColor = TFT_BLACK;
     TFT_eSPI *_Disp;
     XPT2046  *_Touch;
 };
@@ -64,14 +102,13 @@ class Clock : public Base
     static const int _ytop = 4;
 
   private:
+    void Render();
     TimeOfDay _time;
     bool _ch,_cm,_cs;
     bool _reDraw;
 
   protected:
     Base * B;
-    TFT_eSPI *_Disp  = B->getDisplay(); 
-    XPT2046  *_Touch = B->getTouch();
     bool State;
 };
 
@@ -81,48 +118,88 @@ class BusScreen : public Base
   public:
     BusScreen(Base * _b);
     void updateBusStop(KVGbusStop newStop);
+    void setStale(bool stale);
     void setReDrawFlag();
     void Draw();
 
   private:
-    void DrawHeader(); 
+    void Render();
+    void RecordHeader(); 
     KVGbusStop _busStop;
     KVGbusStop _newStop;
     bool _reDraw;
+    bool _stale = false;          // Departures from before the restart
     static const int Y_HEAD = 34;
     static const int Y_LIST = 68;
     static const int ROW_HEIGHT = 30;
     static const uint16_t TFT_GREY = 0x5AEB;
+    TFT_eDisplayList _header;
 
   protected:
     Base * B;
-    TFT_eSPI *_Disp  = B->getDisplay(); 
-    XPT2046  *_Touch = B->getTouch();
     bool State;
 };
 
 
+/**
+  Chart model of one graph series: the screen area, the scale and the screen
+  rows of the 48 hourly samples. setData() maps the samples with integer math
+  when the forecast changes, drawing uses the cached rows.
+*/
+class GraphModel
+{
+  public:
+    GraphModel(int16_t x, int16_t y, int16_t w, int16_t h);
+    void setData(const int16_t data[], GraphScale s);
+    void setData(const uint8_t data[], GraphScale s);
+    int16_t row(int16_t value);
+    const int16_t x, y, w, h, dx;
+    GraphScale scale;
+    int16_t rows[48];
+};
+
+
 class WeatherScreen : public Base
 {
   public:
     WeatherScreen(Base * _b);
-    void updateWeather(WeatherForecast newWeather);
+    void updateWeather(const WeatherForecast &newWeather);
+    void setStale(bool stale);
     void setReDrawFlag();
     void Draw();
 
   private:
-    void DrawGraphBG(int x,int y,int w,int h, float ymin, float ymax, float ystep, String description, bool showXscale);
-    void DrawTempGraph(int x,int y,int w,int h, float data[]);
-    void DrawRainGraph(int x,int y,int w,int h, float rInt[], float rProb[]);
-    void DrawWindGraph(int x,int y,int w,int h, int wDir[], int wSpd[]);
-    void DrawWindArrow(int x, int y, float rad, int dir, uint32_t color);
+    void Render();
+    void RecordGraphs();
+    void RecordGraphBG(GraphModel &g, const char *description, bool showXscale);
+    template <class Canvas> void GraphBG(Canvas &c, GraphModel &g, const char *description, bool showXscale);
+    void UpdateGraphBG(TFT_eDisplayList &list, bool &direct, int x,int y,int w,int h);
+    void DrawGraphBG(TFT_eDisplayList &list, bool direct, GraphModel &g, const char *description, bool showXscale);
+    GraphScale TempScale(const int16_t data[]);
+    GraphScale RainScale(const uint8_t rInt[]);
+    GraphScale WindScale(const uint8_t wSpd[]);
+    void DrawTempGraph();
+    void DrawRainGraph();
+    void DrawWindGraph();
+    void SetWindArrow(WindArrow &arrow, uint8_t dir, int rad);
+    void DrawWindArrow(int x, int y, const WindArrow &arrow, uint32_t color);
     bool _reDraw;
-    WeatherForecast _actualWeather;
+    bool _rescale = false;
+    bool _stale = false;          // Forecast from before the restart
+    int _hour = -1;
+    const WeatherForecast *_actualWeather = NULL;
+    // Graph backgrounds, _newBG takes the next recording to find what changed
+    TFT_eDisplayList _tempBG, _rainBG, _windBG, _newBG;
+    // The background did not fit its list, it is drawn without the list
+    bool _tempDirect = false, _rainDirect = false, _windDirect = false;
+    // Every third hour of the wind graph has an arrow
+    static const int WIND_ARROWS = 16;
+    WindArrow _arrows[WIND_ARROWS];
+    // Projected forecast, the rain graph shows the intensity and the probability
+    GraphModel _temp, _rain, _rainProb, _wind;
 
   protected:
     Base * B;
-    TFT_eSPI *_Disp  = B->getDisplay(); 
-    XPT2046  *_Touch = B->getTouch();
     bool State;
 };
 
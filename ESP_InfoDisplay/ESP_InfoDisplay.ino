@@ -29,8 +29,29 @@
 
 // *** DEFINITIONS ***
 
-#define TIMER_INTERVAL_WIFI  5000     // Wifi Loop 12x per minute
+#define DEBUG_InfoDisplay 0
+
+#define TIMER_INTERVAL_WIFI  5000     // Wifi Loop 12x per minute, one bus stop is refreshed per loop
 #define TIMER_INTERVAL_CLOCK 1000     // Refresh displayed clock time every second
+#define TIMER_INTERVAL_WEATHER 3600000 // Weather forecast every hour
+#define TIMER_INTERVAL_NTP   3600000  // NTP time sync every hour
+#define TIMER_INTERVAL_SNAPSHOT 600000 // Save changed data to flash at most every 10 minutes
+#define TIMER_RETRY          3000     // Retry of a failed NTP sync or a postponed request
+#define TIMER_SLICE_HTTP     20       // Time per loop for a running web request (ms)
+#define TIMER_DEBOUNCE_TOUCH 300      // Touches closer than this count as one
+
+#define TOUCH_IRQ_PIN        D1
+
+// Gateway mode: KVG and DarkSky are read by tools/host/gateway, which sends the
+// displays only the departures and the forecast they show. Empty for direct queries.
+#define GATEWAY_HOST         ""
+#define GATEWAY_PORT         8080
+
+// Task priorities, higher runs first
+#define PRIO_TOUCH           3
+#define PRIO_DISPLAY         2
+#define PRIO_NETWORK         1
+#define PRIO_REFRESH         0
 
 // *** LIBRARIES ***
 
@@ -41,10 +62,12 @@
 #include <TimeLib.h>
 #include <Time.h>
 
+// Flash file system
+#include <FS.h>
+
 // ESP8266 WiFi connection
 #include <ESP8266WiFi.h>
 #include <ESP8266WiFiMulti.h>
-#include <ESP8266HTTPClient.h>
 
 // ILI9341 display
 #include <TFT_eSPI.h>
@@ -53,45 +76,68 @@
 
 // KVG live interface
 #include "KVGliveAPI.h"
+#include "KVGStopCache.h"
 // DarkSky Weather Interface
 #include "DarkSkyAPI.h"
 // Display classes
 #include "Display.h"
+// Task scheduler
+#include "Scheduler.h"
+// Shown data saved for the next start
+#include "Snapshot.h"
 
 // *** PROTOTYPES ***
 
 // NTP prototype for TimeLib syncClient
 time_t getNtpTime();
 
+// Tasks
+void touchISR();
+void touchTask();
+void displayTask();
+void networkTask();
+void busStopTask();
+void weatherTask();
+void snapshotTask();
+void NTP_requestTask();
+void NTP_receiveTask();
+
 // *** VARIABLES ***
 
 // Multi Wifi Connection
 //ESP8266WiFiMulti WiFiMulti;
-// HTTP Client
-HTTPClient http;
 // TFT Display
 TFT_eSPI tft = TFT_eSPI();
 // Touch controller
-XPT2046 touch(/*cs=*/ D2, /*irq=*/ D1);
+XPT2046 touch(/*cs=*/ D2, /*irq=*/ TOUCH_IRQ_PIN);
 
 // KVG live interface
-KVGliveAPI KVG(http);
+KVGliveAPI KVG;
+// Departures of all bus stops shown
+KVGStopCache stops(KVG);
 // DarkSky Weather interface
-DarkSkyAPI Weather(http);
+DarkSkyAPI Weather;
 // Display base
 Base B(&tft, &touch);
 // Display elements
 Clock clk(&B);
 BusScreen bus(&B);
 WeatherScreen wscr(&B);
+// Forecast and departures saved in flash
+Snapshot snapshot;
+// A forecast is shown, the snapshot is older than the shown data
+bool haveWeather = false, snapshotChanged = false;
 
-// Global timer variable for WiFi request interval
-uint32_t timerWifi;
-// when the digital clock was displayed
-uint32_t timerClock; 
+// Tasks run from loop()
+Scheduler tasks;
+int8_t taskTouch, taskDisplay, taskNetwork, taskBusStops, taskWeather, taskSnapshot, taskNtp, taskNtpReceive;
+// when the display was touched last
+uint32_t lastTouch;
 
 // Current display mode (0: Weather screen, 1: 1st KVG stop, 2: 2nd KVG stop, ...)
 uint8_t mode = 0;
+// Version of the shown departures, see KVGStopCache::version()
+uint32_t busShown = 0xFFFFFFFF;
 
 
 // *** MAIN FUNCTIONS ***
@@ -102,105 +148,189 @@ void setup(void) {
   
   Serial.begin(115200);
 
+  // Bus stops for display modes 1, 2, 3
+  stops.addStop(KVGliveAPI::KVGstop::Wrangelstrasse);
+  stops.addStop(KVGliveAPI::KVGstop::Schauspielhaus);
+  stops.addStop(KVGliveAPI::KVGstop::WaitzHoltenauer);
+
+  // Read departures and forecast from the gateway
+  if (*GATEWAY_HOST)
+  {
+    KVG.useGateway(GATEWAY_HOST, GATEWAY_PORT);
+    Weather.useGateway(GATEWAY_HOST, GATEWAY_PORT);
+  }
+
   B.initDispAndTouch();
 
+  // Show the data saved before the restart right away, in grey until it is read again
+  WeatherForecast saved;
+  snapshot.begin();
+  bool restored = snapshot.load(saved, stops);
+  if (restored)
+  {
+    Weather.setWeather(saved);
+    wscr.updateWeather(Weather.readWeather());
+    wscr.setStale(true);
+    wscr.Draw();
+    haveWeather = true;
+  }
+
   // Setup connection
   WiFi.begin("SSID", "Your Wifi Password");
   
-  int counter = 0;
-  // Wait for WiFi Connection
-  while (WiFi.status() != WL_CONNECTED)
+  // Without saved data wait for WiFi Connection and the first forecast
+  if (!restored)
   {
-    B.drawLogoSpinner(counter,WiFi_Logo_bits,WiFi_Logo_width,WiFi_Logo_height);
-    delay(500);
-    counter++;
+    int counter = 0;
+    while (WiFi.status() != WL_CONNECTED)
+    {
+      B.drawLogoSpinner(counter,WiFi_Logo_rle,WiFi_Logo_width,WiFi_Logo_height);
+      delay(500);
+      counter++;
+    }
+    B.clearScreen();
   }
-  B.clearScreen();
 
   // Start time synchronization with NTP server
   NTP_startSync();
-  setSyncInterval(3);
  
   // Read weather information
-  B.drawCenterXbm(W1_Logo_width, W1_Logo_height, W1_Logo_bits, TFT_WHITE);
-  B.drawCenterXbm(W2_Logo_width, W2_Logo_height, W2_Logo_bits, TFT_YELLOW);
-  if (timeStatus() != timeNotSet) Weather.UTCmidnightTime = now() - hour()*3600 - minute()*60 - second();
-  Weather.queryWeather(DarkSkyAPI::Location::Kiel);  
-  wscr.updateWeather(Weather.readWeather());
-  B.clearScreen();    
+  if (!restored)
+  {
+    B.drawCenterRle(W1_Logo_width, W1_Logo_height, W1_Logo_rle, TFT_WHITE);
+    B.drawCenterRle(W2_Logo_width, W2_Logo_height, W2_Logo_rle, TFT_YELLOW);
+    haveWeather = snapshotChanged = Weather.queryWeather(DarkSkyAPI::Location::Kiel);  
+    wscr.updateWeather(Weather.readWeather());
+    B.clearScreen();    
+  }
   digitalWrite(D0, LOW);
+
+  // Tasks
+  taskTouch      = tasks.add(touchTask, 0, PRIO_TOUCH, false);
+  taskDisplay    = tasks.add(displayTask, TIMER_INTERVAL_CLOCK, PRIO_DISPLAY);
+  taskNetwork    = tasks.add(networkTask, 0, PRIO_NETWORK, false);
+  taskBusStops   = tasks.add(busStopTask, TIMER_INTERVAL_WIFI, PRIO_REFRESH);
+  taskWeather    = tasks.add(weatherTask, TIMER_INTERVAL_WEATHER, PRIO_REFRESH);
+  taskSnapshot   = tasks.add(snapshotTask, TIMER_INTERVAL_SNAPSHOT, PRIO_REFRESH);
+  taskNtp        = tasks.add(NTP_requestTask, TIMER_INTERVAL_NTP, PRIO_REFRESH);
+  taskNtpReceive = tasks.add(NTP_receiveTask, 0, PRIO_NETWORK, false);
+  tasks.runIn(taskNtp, 0);
+  tasks.runIn(taskBusStops, 0);
+  // The saved forecast is replaced as soon as WiFi is up
+  if (restored) tasks.runIn(taskWeather, 0);
+  tasks.trigger(taskDisplay);
+  
+  attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ_PIN), touchISR, FALLING);
 }
 
 void loop() {
-  // Touch handling
-  if (touch.isTouching()) {
-    mode += 1;
-    if (mode == 4) mode = 0;
-    
-    timerWifi = 0;
-
-    B.clearScreen(); 
-    bus.setReDrawFlag();  
-    clk.setReDrawFlag(); 
-    wscr.setReDrawFlag(); 
-    // Don't use position reading
-    //    uint16_t x, y;
-    //    touch.getPosition(x, y);
-    //    switch (tftMode)
-    //
-    //
-    //    prev_x = x;
-    //    prev_y = y;
-    //  } else {
-    //    prev_x = prev_y = 0xffff;
-  }
+  // Run the most urgent task, then sleep until the next one is due or the display is touched
+  tasks.idle(tasks.run());
+}
 
-  // Wifi connection
-  if (millis() > timerWifi && WiFi.status() == WL_CONNECTED)
-  {
-    timerWifi = millis() + TIMER_INTERVAL_WIFI;
-    int stopNr;
-    // Mode 0: Show weather forecast
-    if (mode == 0) {
-      timerWifi = millis() + 3600000;
-      wscr.Draw();     
-    }
-    // Mode > 0: Show KVG bus stops
-    else {
-      switch (mode) {
-        case 1: 
-          stopNr = KVGliveAPI::KVGstop::Wrangelstrasse;
-          break;
-        case 2:
-          stopNr = KVGliveAPI::KVGstop::Schauspielhaus;
-          break;
-        case 3:
-          stopNr = KVGliveAPI::KVGstop::WaitzHoltenauer;
-          break;
-      } 
+
+// *** TASKS ***
+
+// The touch controller pulls its IRQ line low when touched
+ICACHE_RAM_ATTR void touchISR() {
+  tasks.trigger(taskTouch);
+}
+
+// Touch handling
+void touchTask() {
+  if (!touch.isTouching() || (millis() - lastTouch < TIMER_DEBOUNCE_TOUCH)) return;
+  lastTouch = millis();
   
-      if (KVG.queryBusStop(stopNr))
-      {
-        bus.updateBusStop(KVG.readBusStop());
-        bus.Draw();
-      }
-    }
-    
+  mode += 1;
+  if (mode == stops.count() + 1) mode = 0;
+  
+  // The next screen replaces this one without clearing the display first
+  B.beginTransition();
+  bus.setReDrawFlag();  
+  clk.setReDrawFlag(); 
+  wscr.setReDrawFlag(); 
+  busShown = 0xFFFFFFFF;
+  // Draw the new screen right away from the cache
+  tasks.trigger(taskDisplay);
+  // Don't use position reading
+  //    uint16_t x, y;
+  //    touch.getPosition(x, y);
+}
 
+// Screen refresh every second
+void displayTask() {
+  // Mode 0: Show weather forecast
+  if (mode == 0) {
+    wscr.Draw();     
   }
-
-  // Clock display on KVG screens
-  if (timeStatus() != timeNotSet && mode != 0)
-  {
-    if (millis() > timerClock)
+  // Mode > 0: Show KVG bus stops, only if they changed since they were drawn
+  else {
+    if (stops.isValid(mode - 1) && (stops.version(mode - 1) != busShown))
+    {
+      busShown = stops.version(mode - 1);
+      bus.setStale(stops.isStale(mode - 1));
+      bus.updateBusStop(stops.readBusStop(mode - 1));
+      bus.Draw();
+    }
+    // Clock display on KVG screens
+    if (timeStatus() != timeNotSet)
     {
-      timerClock = millis() + TIMER_INTERVAL_CLOCK;
       clk.updateTime((TimeOfDay) {hour(), minute(), second()});
       clk.Draw();
     }
   }
+  // After a touch the elements have only marked their areas, show them together
+  B.endTransition();
+}
 
-  delay(50);
+// Advances the running web request by a short time slice, so the clock and
+// touch keep working during downloads
+void networkTask() {
+  if (Weather.busy())
+  {
+    if (Weather.update(TIMER_SLICE_HTTP) == HttpFetch::DONE)
+    {
+      wscr.updateWeather(Weather.readWeather());
+      wscr.setStale(false);
+      haveWeather = snapshotChanged = true;
+    }
+  }
+  else if (stops.busy())
+  {
+    if (stops.update(TIMER_SLICE_HTTP)) snapshotChanged = true;
+  }
+  
+  if (Weather.busy() || stops.busy()) tasks.runIn(taskNetwork, 0);
 }
 
+// Refresh the bus stops one after the other in the background
+void busStopTask() {
+  if ((WiFi.status() != WL_CONNECTED) || Weather.busy()) return;
+  if (stops.refreshNext()) tasks.runIn(taskNetwork, 0);
+}
+
+// Weather forecast
+void weatherTask() {
+  if (DEBUG_InfoDisplay) tasks.printStats(Serial);
+  
+  // One request at a time, try again when the bus stop is read
+  if ((WiFi.status() != WL_CONNECTED) || stops.busy())
+  {
+    tasks.runIn(taskWeather, TIMER_RETRY);
+    return;
+  }
+  if (Weather.beginQuery(DarkSkyAPI::Location::Kiel)) tasks.runIn(taskNetwork, 0);
+}
 
+// Saves the shown data for the next start. Only changed data is written and
+// not more often than the task interval, the flash wears with every write.
+void snapshotTask() {
+  if (!haveWeather || !snapshotChanged) return;
+  // Writing the flash blocks for a while, don't stall a running download
+  if (Weather.busy() || stops.busy())
+  {
+    tasks.runIn(taskSnapshot, TIMER_RETRY);
+    return;
+  }
+  if (snapshot.save(Weather.readWeather(), stops)) snapshotChanged = false;
+}
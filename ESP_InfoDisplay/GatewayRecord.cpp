@@ -0,0 +1,171 @@
+/**
+  Gateway record
+  Name: GatewayRecord.cpp
+  Purpose: Binary records of a forecast or the departures of a stop, as served by tools/host/gateway (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+
+  Numbers are little endian, strings are stored with a length byte in front.
+  Both records start with GATEWAY_RECORD_VERSION.
+    forecast: icon, temperature, wind speed and direction, local time of the
+              current weather (4 bytes), then the 48 hour arrays of
+              WeatherForecast
+    stop:     stop name, then per departure number, direction, time,
+              minutes and delay
+  The layout follows the snapshot, the values are those of WeatherForecast
+  and KVGbus.
+*/
+
+#include "Arduino.h"
+#include "GatewayRecord.h"
+#include "DarkSkyAPI.h"
+#include "KVGliveAPI.h"
+
+// Public functions
+
+/**
+  Starts a new record, called before the request.
+*/
+void GatewayRecord::begin()
+{
+  _length = 0;
+  _overflow = false;
+}
+
+void GatewayRecord::body(const uint8_t *data, size_t length)
+{
+  if (_length + length > GATEWAY_RECORD_MAX)
+  {
+    _overflow = true;
+    return;
+  }
+  memcpy(_data + _length, data, length);
+  _length += length;
+}
+
+/**
+  Reads a complete forecast record. The changed flags are not set. Returns
+  false if the record is no forecast of this version.
+*/
+bool GatewayRecord::readWeather(WeatherForecast &weather, uint32_t &localTime)
+{
+  if (_overflow || (_length != GATEWAY_WEATHER_SIZE) || (_data[0] != GATEWAY_RECORD_VERSION)) return false;
+
+  const uint8_t *in = _data + 1;
+  weather.actIco = (WeatherIcon)*in++;
+  weather.actTemp = (int16_t)(in[0] | (in[1] << 8));
+  in += 2;
+  weather.actWindSpd = *in++;
+  weather.actWindDir = *in++;
+  localTime = in[0] | (in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+  in += 4;
+  for (uint8_t i = 0; i < 48; i++, in += 2) weather.fTemp[i] = (int16_t)(in[0] | (in[1] << 8));
+  memcpy(weather.fRainProb, in, 48);   in += 48;
+  memcpy(weather.fRainInt, in, 48);    in += 48;
+  memcpy(weather.fWindSpd, in, 48);    in += 48;
+  memcpy(weather.fWindDir, in, 48);    in += 48;
+  memcpy(weather.fCloudCover, in, 48);
+  return true;
+}
+
+/**
+  Reads a complete stop record into stop, all departure rows are set. Returns
+  false if the record is no stop of this version or cut off, then stop may
+  be changed in part.
+*/
+bool GatewayRecord::readBusStop(KVGbusStop &stop)
+{
+  if (_overflow || (_length == 0) || (_data[0] != GATEWAY_RECORD_VERSION)) return false;
+
+  size_t pos = 1;
+  if (!readString(pos, stop.stopName)) return false;
+  for (uint8_t row = 0; row < KVG_DEPARTURES; row++)
+  {
+    KVGbus &bus = stop.departures[row];
+    if (!readString(pos, bus.number) || !readString(pos, bus.dir) || !readString(pos, bus.depTime)) return false;
+    if (pos + 2 > _length) return false;
+    bus.depMinutes = (int8_t)_data[pos++];
+    bus.depDelay = (int8_t)_data[pos++];
+  }
+  return pos == _length;
+}
+
+/**
+  fnv1a() of the received record, the gateway sends it as ETag.
+*/
+uint32_t GatewayRecord::hash()
+{
+  return fnv1a(FNV1A_BASIS, _data, _length);
+}
+
+/**
+  Writes a forecast record of GATEWAY_WEATHER_SIZE bytes to out.
+*/
+size_t GatewayRecord::writeWeather(uint8_t *out, const WeatherForecast &weather, uint32_t localTime)
+{
+  uint8_t *p = out;
+  *p++ = GATEWAY_RECORD_VERSION;
+  *p++ = weather.actIco;
+  *p++ = weather.actTemp & 0xFF;
+  *p++ = (weather.actTemp >> 8) & 0xFF;
+  *p++ = weather.actWindSpd;
+  *p++ = weather.actWindDir;
+  for (uint8_t i = 0; i < 4; i++) *p++ = (localTime >> (8 * i)) & 0xFF;
+  for (uint8_t i = 0; i < 48; i++)
+  {
+    *p++ = weather.fTemp[i] & 0xFF;
+    *p++ = (weather.fTemp[i] >> 8) & 0xFF;
+  }
+  memcpy(p, weather.fRainProb, 48);   p += 48;
+  memcpy(p, weather.fRainInt, 48);    p += 48;
+  memcpy(p, weather.fWindSpd, 48);    p += 48;
+  memcpy(p, weather.fWindDir, 48);    p += 48;
+  memcpy(p, weather.fCloudCover, 48); p += 48;
+  return p - out;
+}
+
+/**
+  Writes a stop record to out, which holds GATEWAY_RECORD_MAX bytes. Names
+  longer than GATEWAY_STRING_MAX are cut off, so the record always fits.
+*/
+size_t GatewayRecord::writeBusStop(uint8_t *out, const KVGbusStop &stop)
+{
+  uint8_t *p = out;
+  *p++ = GATEWAY_RECORD_VERSION;
+  p = writeString(p, stop.stopName);
+  for (uint8_t row = 0; row < KVG_DEPARTURES; row++)
+  {
+    const KVGbus &bus = stop.departures[row];
+    p = writeString(p, bus.number);
+    p = writeString(p, bus.dir);
+    p = writeString(p, bus.depTime);
+    *p++ = (uint8_t)bus.depMinutes;
+    *p++ = (uint8_t)bus.depDelay;
+  }
+  return p - out;
+}
+
+
+// Private functions
+
+uint8_t *GatewayRecord::writeString(uint8_t *out, const String &s)
+{
+  uint8_t len = min(s.length(), (unsigned int)GATEWAY_STRING_MAX);
+  *out++ = len;
+  memcpy(out, s.c_str(), len);
+  return out + len;
+}
+
+bool GatewayRecord::readString(size_t &pos, String &s)
+{
+  char buf[GATEWAY_STRING_MAX + 1];
+  if (pos >= _length) return false;
+  uint8_t len = _data[pos++];
+  if ((len > GATEWAY_STRING_MAX) || (pos + len > _length)) return false;
+  memcpy(buf, _data + pos, len);
+  buf[len] = '\0';
+  pos += len;
+  s = buf;
+  return true;
+}
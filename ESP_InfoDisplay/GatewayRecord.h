@@ -0,0 +1,48 @@
+/**
+  Gateway record Header
+  Name: GatewayRecord.h
+  Purpose: Binary records of a forecast or the departures of a stop, as served by tools/host/gateway (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#ifndef GatewayRecord_h
+#define GatewayRecord_h
+
+#define GATEWAY_RECORD_VERSION 1     // Change when the layout of a record changes
+#define GATEWAY_RECORD_MAX     621   // Largest record, a stop with all 19 names GATEWAY_STRING_MAX long
+#define GATEWAY_STRING_MAX     31    // Longer names are cut off
+#define GATEWAY_WEATHER_SIZE   346   // A forecast record has always this size
+
+#include "Arduino.h"
+// Body handler
+#include "HttpFetch.h"
+
+struct WeatherForecast;
+struct KVGbusStop;
+
+/**
+  Collects a record while it is received and reads it into the structures of
+  the sketch. The write functions are used by the gateway.
+*/
+class GatewayRecord: public BodyHandler
+{
+  public:
+    void begin();
+    virtual void body(const uint8_t *data, size_t length);
+    bool readWeather(WeatherForecast &weather, uint32_t &localTime);
+    bool readBusStop(KVGbusStop &stop);
+    uint32_t hash();
+    static size_t writeWeather(uint8_t *out, const WeatherForecast &weather, uint32_t localTime);
+    static size_t writeBusStop(uint8_t *out, const KVGbusStop &stop);
+
+  private:
+    static uint8_t *writeString(uint8_t *out, const String &s);
+    bool readString(size_t &pos, String &s);
+    uint8_t _data[GATEWAY_RECORD_MAX];
+    size_t _length;
+    bool _overflow;               // The record did not fit into _data
+};
+
+#endif
@@ -0,0 +1,261 @@
+/**
+  Non-blocking HTTP fetch
+  Name: HttpFetch.cpp
+  Purpose: Runs a HTTP GET in small steps and feeds the body to a JSON or body handler (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#include "Arduino.h"
+#include "HttpFetch.h"
+
+/**
+  Starts a request, the work is done by update(). HTTP/1.0 is used so the body
+  is never chunked. timeout is the time in ms the whole request may take.
+  With a validator the request is conditional: if the server answers "304 Not
+  Modified", the request is DONE without a body and notModified() is true.
+*/
+bool HttpFetch::begin(WiFiClient &client, const char* host, uint16_t port, const String &path, JsonHandler *handler, uint32_t timeout, HttpValidator *validator)
+{
+  if (!start(client, host, port, path, timeout, validator)) return false;
+  _handler = handler;
+  _handler->start(_json);
+  return true;
+}
+
+/**
+  Starts a request whose body is handed over unparsed.
+*/
+bool HttpFetch::begin(WiFiClient &client, const char* host, uint16_t port, const String &path, BodyHandler *handler, uint32_t timeout, HttpValidator *validator)
+{
+  if (!start(client, host, port, path, timeout, validator)) return false;
+  _bodyHandler = handler;
+  return true;
+}
+
+/**
+  Advances the request for at most budget ms. Connecting and sending are
+  done in calls of their own as they can not be split (the TLS handshake of
+  WiFiClientSecure blocks until it is done).
+*/
+HttpFetch::State HttpFetch::update(uint32_t budget)
+{
+  uint32_t start = millis();
+
+  if (busy() && (millis() - _started > _timeout))
+  {
+    if (DEBUG_HttpFetch) Serial.println(String(_host) + ": timeout");
+    abort();
+  }
+
+  switch (_state)
+  {
+    case CONNECT:
+      if (DEBUG_HttpFetch) Serial.println(String("connecting to ") + _host);
+      if (_client->connect(_host, _port)) 
+      {
+        _state = SEND;
+      }
+      else
+      {
+        Serial.println("connection failed");
+        _state = FAILED;
+      }
+      break;
+
+    case SEND:
+      if (DEBUG_HttpFetch) Serial.println("requesting URL: " + _path);
+    {
+      String request = String("GET ") + _path + " HTTP/1.0\r\n" +
+                       "Host: " + _host + "\r\n" +
+                       "User-Agent: ESP_InfoDisplay\r\n";
+      if (_validator && _validator->etag[0]) request += String("If-None-Match: ") + _validator->etag + "\r\n";
+      if (_validator && _validator->lastModified[0]) request += String("If-Modified-Since: ") + _validator->lastModified + "\r\n";
+      _client->print(request + "Connection: close\r\n\r\n");
+    }
+      _state = HEADERS;
+      break;
+
+    case HEADERS:
+    case BODY:
+      // A header line may end the request, e.g. "304 Not Modified"
+      while (busy() && (millis() - start < budget))
+      {
+        int avail = _client->available();
+        if (avail <= 0)
+        {
+          // Without Content-Length the body ends when the server closes, a
+          // JSON body must be complete by then
+          if (!_client->connected())
+          {
+            if ((_state == BODY) && (_length < 0) && (_bodyHandler || _json.done())) finish();
+            else abort();
+          }
+          break;
+        }
+
+        if (_state == HEADERS)
+        {
+          char c = _client->read();
+          if (c == '\n') readHeaderLine();
+          else if ((c != '\r') && (_lineLen < HTTP_LINE_MAX - 1)) _line[_lineLen++] = c;
+        }
+        else
+        {
+          uint8_t buf[64];
+          int n = _client->read(buf, min(avail, (int)sizeof(buf)));
+          if (_bodyHandler)
+          {
+            _bodyHandler->body(buf, n);
+          }
+          else
+          {
+            _json.input(buf, n);
+            _handler->parse(_json);
+          }
+          if (_length > 0) _length -= n;
+          if (_json.failed()) { abort(); break; }
+          // The document is complete, the server may still be sending whitespace
+          if (_json.done()) { finish(); break; }
+          // A JSON body has to end with the last byte of Content-Length
+          if (_length == 0)
+          {
+            if (_bodyHandler) finish();
+            else abort();
+            break;
+          }
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+  return _state;
+}
+
+/**
+  Common part of both begin(), no handler is set.
+*/
+bool HttpFetch::start(WiFiClient &client, const char* host, uint16_t port, const String &path, uint32_t timeout, HttpValidator *validator)
+{
+  if (busy()) return false;
+  
+  _client = &client;
+  _host = host;
+  _port = port;
+  _path = path;
+  _json.reset();
+  _handler = NULL;
+  _bodyHandler = NULL;
+  _validator = validator;
+  _received = HttpValidator();
+  _started = millis();
+  _timeout = timeout;
+  _status = 0;
+  _length = -1;
+  _lineLen = 0;
+  _state = CONNECT;
+  return true;
+}
+
+/**
+  Evaluates a complete header line, the empty line starts the body.
+*/
+void HttpFetch::readHeaderLine()
+{
+  _line[_lineLen] = '\x00';
+  _lineLen = 0;
+  if (DEBUG_HttpFetch) Serial.println(_line);
+  
+  // Status line: "HTTP/1.1 200 OK"
+  if (_status == 0)
+  {
+    const char *code = strchr(_line, ' ');
+    _status = code ? atoi(code + 1) : -1;
+  }
+  else if (strncasecmp(_line, "Content-Length:", 15) == 0)
+  {
+    _length = atol(_line + 15);
+  }
+  else if (strncasecmp(_line, "ETag:", 5) == 0)
+  {
+    readValidator(_line + 5, _received.etag);
+  }
+  else if (strncasecmp(_line, "Last-Modified:", 14) == 0)
+  {
+    readValidator(_line + 14, _received.lastModified);
+  }
+  else if (_line[0] == '\x00')
+  {
+    if (_status == 200) _state = BODY;
+    // The content is still the one of the validator that was sent
+    else if ((_status == 304) && _validator && (_validator->etag[0] || _validator->lastModified[0])) finish();
+    else abort();
+  }
+}
+
+/**
+  Keeps the value of a validator header, values that may have been cut off at
+  HTTP_LINE_MAX or don't fit are dropped.
+*/
+void HttpFetch::readValidator(const char *value, char *to)
+{
+  while (*value == ' ') value++;
+  if ((strlen(_line) >= HTTP_LINE_MAX - 1) || (strlen(value) >= HTTP_VALIDATOR_MAX)) return;
+  strcpy(to, value);
+}
+
+/**
+  Ends the request successfully, e.g. when the listener has all data it needs.
+  The validator of a 200 response is kept for the next request, so this is
+  only for complete responses, all others go through abort().
+*/
+void HttpFetch::finish()
+{
+  if (_client) _client->stop();
+  if (_validator && (_status == 200)) *_validator = _received;
+  _state = DONE;
+}
+
+/**
+  Ends the request as failed. The validator is cleared, the next request of
+  the resource reads it completely.
+*/
+void HttpFetch::abort()
+{
+  if (_client) _client->stop();
+  if (_validator) *_validator = HttpValidator();
+  _state = FAILED;
+}
+
+HttpFetch::State HttpFetch::state()
+{
+  return _state;
+}
+
+/**
+  True while the request is running.
+*/
+bool HttpFetch::busy()
+{
+  return (_state != IDLE) && (_state != DONE) && (_state != FAILED);
+}
+
+/**
+  HTTP status code, 0 until the status line has been received.
+*/
+int HttpFetch::status()
+{
+  return _status;
+}
+
+/**
+  True if the request is DONE because the content did not change since the
+  response the validator is from.
+*/
+bool HttpFetch::notModified()
+{
+  return (_state == DONE) && (_status == 304);
+}
@@ -0,0 +1,104 @@
+/**
+  Non-blocking HTTP fetch Header
+  Name: HttpFetch.h
+  Purpose: Runs a HTTP GET in small steps and feeds the body to a JSON or body handler (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#ifndef HttpFetch_h
+#define HttpFetch_h
+
+#define DEBUG_HttpFetch 0
+
+#define HTTP_LINE_MAX 64          // Longest header line that is evaluated
+#define HTTP_VALIDATOR_MAX 40     // Longest ETag or Last-Modified that is kept
+#define FNV1A_BASIS 2166136261UL  // Start value of fnv1a()
+
+#include "Arduino.h"
+#include <ESP8266WiFi.h>
+// JSON tokenizer
+#include "JsonTokenizer.h"
+
+/**
+  ETag and Last-Modified of the last response, sent along with the next
+  request of the same resource. Empty if the server sent none.
+*/
+struct HttpValidator
+{
+  char etag[HTTP_VALIDATOR_MAX] = "";
+  char lastModified[HTTP_VALIDATOR_MAX] = "";
+};
+
+/**
+  FNV-1a hash continued over data, to notice responses whose content did not
+  change.
+*/
+inline uint32_t fnv1a(uint32_t hash, const void *data, size_t length)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  while (length--) hash = (hash ^ *p++) * 16777619UL;
+  return hash;
+}
+
+/**
+  Reads the tokens of a response. start() is called before the body, e.g. to
+  select the keys. parse() is called for every piece of the body and takes
+  the tokens with next() until it returns false.
+*/
+class JsonHandler
+{
+  public:
+    virtual ~JsonHandler() {}
+    virtual void start(JsonTokenizer &) {}
+    virtual void parse(JsonTokenizer &json) = 0;
+};
+
+/**
+  Takes the body as it is received, e.g. the binary records of the gateway.
+*/
+class BodyHandler
+{
+  public:
+    virtual ~BodyHandler() {}
+    virtual void body(const uint8_t *data, size_t length) = 0;
+};
+
+class HttpFetch
+{
+  public:
+    enum State : uint8_t {IDLE, CONNECT, SEND, HEADERS, BODY, DONE, FAILED};
+    bool begin(WiFiClient &client, const char* host, uint16_t port, const String &path, JsonHandler *handler, uint32_t timeout, HttpValidator *validator = NULL);
+    bool begin(WiFiClient &client, const char* host, uint16_t port, const String &path, BodyHandler *handler, uint32_t timeout, HttpValidator *validator = NULL);
+    State update(uint32_t budget);
+    void finish();
+    void abort();
+    State state();
+    bool busy();
+    int status();
+    bool notModified();
+
+  private:
+    bool start(WiFiClient &client, const char* host, uint16_t port, const String &path, uint32_t timeout, HttpValidator *validator);
+    void readHeaderLine();
+    void readValidator(const char *value, char *to);
+    WiFiClient *_client = NULL;
+    const char* _host;
+    uint16_t _port;
+    String _path;
+    JsonTokenizer _json;
+    JsonHandler *_handler;
+    BodyHandler *_bodyHandler;    // Instead of _handler for bodies that are no JSON
+    HttpValidator *_validator;    // Sent with the request, replaced by the one of a complete response
+    HttpValidator _received;      // Of the running response
+    State _state = IDLE;
+    uint32_t _started;
+    uint32_t _timeout;
+    int _status;
+    int32_t _length;              // Remaining body bytes, -1 if not given
+    char _line[HTTP_LINE_MAX];
+    uint8_t _lineLen;
+};
+
+#endif
@@ -0,0 +1,558 @@
+/**
+  Streaming JSON tokenizer
+  Name: JsonTokenizer.h
+  Purpose: Splits a JSON document into tokens while it is received, without
+           allocating memory (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+
+  The document is handed over in pieces with input(), next() then returns the
+  tokens one after the other until the piece is used up. A value inside an
+  object comes as one token together with its key, keys are not tokens of
+  their own:
+
+    {"a":[1,"x"]}  ->  BEGIN_OBJECT, BEGIN_ARRAY (key "a"), NUMBER "1",
+                       STRING "x", END_ARRAY, END_OBJECT
+
+  Key and text are views into a fixed buffer and valid until the next call of
+  next(). Longer keys and values are cut off. skip() after a BEGIN token
+  passes over the whole object or array, skipRest() over the rest of an
+  enclosing one. With select() only the values of the listed keys are
+  tokens, all others are skipped as well. Skipped parts are only scanned for
+  their end, nothing of them is stored.
+*/
+
+#ifndef JsonTokenizer_h
+#define JsonTokenizer_h
+
+#define JSON_KEY_MAX      32      // Longest key, including the terminating zero
+#define JSON_BUFFER_MAX   128     // Key and value together
+#define JSON_DEPTH_MAX    32      // Nesting levels of objects and arrays
+#define JSON_SELECT_MAX   16      // Keys given to select()
+#define JSON_SELECT_SLOTS 32      // Hash table of the selected keys, twice JSON_SELECT_MAX
+
+#include "Arduino.h"
+
+class JsonTokenizer
+{
+  public:
+    enum Type : uint8_t {NONE, BEGIN_OBJECT, END_OBJECT, BEGIN_ARRAY, END_ARRAY, STRING, NUMBER, LITERAL};
+
+    JsonTokenizer() { reset(); }
+    void reset();
+    void input(const uint8_t *data, size_t length);
+    bool next();
+    void skip();
+    void skipRest(uint8_t depth);
+    void select(const char * const *keys);
+
+    // The current token
+    Type type() { return _type; }
+    uint8_t depth() { return _tokenDepth; }
+    const char *key() { return _buffer; }
+    uint8_t field() { return _field; }
+    const char *text() { return _buffer + _keyLength + 1; }
+    uint8_t length() { return _length; }
+    bool isKey(const char *key) { return strcmp(_buffer, key) == 0; }
+    bool isText(const char *text) { return strcmp(this->text(), text) == 0; }
+
+    bool done() { return _state == DONE; }
+    bool failed() { return _state == FAILED; }
+
+  private:
+    // The states from SKIP on are handled by scan()
+    enum State : uint8_t {VALUE, OBJECT, KEY, COLON, AFTER_VALUE, STRING_VALUE, ESCAPE, UNICODE, SCALAR,
+                          SKIP_VALUE, DONE, FAILED, SKIP, SKIP_STRING, SKIP_ESCAPE, SKIP_SCALAR};
+
+    bool token(Type type);
+    bool beginContainer(Type type, bool array);
+    bool endContainer(Type type, bool array);
+    bool endValue(Type type);
+    void selectKey();
+    const uint8_t *copy(const uint8_t *in, const uint8_t *end);
+    const uint8_t *scan(const uint8_t *in, const uint8_t *end);
+    void append(char c);
+    void appendUnicode(uint32_t code);
+    bool inArray() { return _arrays & (1UL << (_depth - 1)); }
+    static bool isWhitespace(char c) { return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r'); }
+    static uint8_t hash(const char *key, uint8_t length);
+
+    const uint8_t *_in;
+    const uint8_t *_end;
+    State _state;
+    State _stringState;           // KEY or STRING_VALUE, for the escapes
+    Type _type;
+    uint8_t _depth;               // Objects and arrays entered
+    uint8_t _tokenDepth;
+    uint8_t _skipDepth;           // Depth of a skipped object or array, 0xFF if none
+    const char * const *_keys;    // Keys given to select()
+    uint8_t _slots[JSON_SELECT_SLOTS];  // Position in _keys plus 1 by hash, 0 for free slots
+    uint8_t _field;               // Position of the key in _keys plus 1, 0 if not listed
+    uint32_t _arrays;             // One bit per depth, set for arrays
+    char _buffer[JSON_BUFFER_MAX];
+    uint8_t _keyLength;
+    uint8_t _length;              // Length of the value
+    uint16_t _unicode;
+    uint8_t _unicodeDigits;
+    uint16_t _highSurrogate;
+};
+
+
+inline void JsonTokenizer::reset()
+{
+  _in = _end = NULL;
+  _state = VALUE;
+  _type = NONE;
+  _depth = _tokenDepth = 0;
+  _skipDepth = 0xFF;
+  _keys = NULL;
+  _field = 0;
+  _arrays = 0;
+  _buffer[0] = _buffer[1] = '\x00';
+  _keyLength = _length = 0;
+  _highSurrogate = 0;
+}
+
+/**
+  Next piece of the document, it must stay valid until next() returns false.
+*/
+inline void JsonTokenizer::input(const uint8_t *data, size_t length)
+{
+  _in = data;
+  _end = data + length;
+}
+
+/**
+  Reads up to the end of the next token. Returns false when the input is used
+  up, the document is complete or it is no valid JSON.
+*/
+inline bool JsonTokenizer::next()
+{
+  // The position stays in a local, as a member it would be reloaded after
+  // every write to _buffer
+  const uint8_t *in = _in;
+  const uint8_t *end = _end;
+  bool found = false;
+
+  while (!found && (in < end))
+  {
+    if (_state >= SKIP)
+    {
+      in = scan(in, end);
+      continue;
+    }
+    if ((_state == KEY) || (_state == STRING_VALUE))
+    {
+      in = copy(in, end);
+      if (in == end) break;
+    }
+
+    char c = *in++;
+    switch (_state)
+    {
+      // copy() stops at the closing quote or an escape
+      case STRING_VALUE:
+      case KEY:
+        if (c == '\\')
+        {
+          _stringState = _state;
+          _state = ESCAPE;
+        }
+        else if (_state == KEY)
+        {
+          _state = COLON;
+        }
+        else
+        {
+          found = endValue(STRING);
+        }
+        break;
+
+      case ESCAPE:
+        _state = _stringState;
+        switch (c)
+        {
+          case 'b': append('\b'); break;
+          case 'f': append('\f'); break;
+          case 'n': append('\n'); break;
+          case 'r': append('\r'); break;
+          case 't': append('\t'); break;
+          case 'u':
+            _unicode = 0;
+            _unicodeDigits = 0;
+            _state = UNICODE;
+            break;
+          default: append(c); break;
+        }
+        break;
+
+      case UNICODE:
+        if ((c >= '0') && (c <= '9'))      _unicode = (_unicode << 4) | (c - '0');
+        else if ((c >= 'a') && (c <= 'f')) _unicode = (_unicode << 4) | (c - 'a' + 10);
+        else if ((c >= 'A') && (c <= 'F')) _unicode = (_unicode << 4) | (c - 'A' + 10);
+        if (++_unicodeDigits < 4) break;
+
+        _state = _stringState;
+        if ((_unicode >= 0xD800) && (_unicode < 0xDC00))
+        {
+          _highSurrogate = _unicode;
+        }
+        else if ((_unicode >= 0xDC00) && (_unicode < 0xE000) && _highSurrogate)
+        {
+          appendUnicode(0x10000 + ((uint32_t)(_highSurrogate - 0xD800) << 10) + (_unicode - 0xDC00));
+          _highSurrogate = 0;
+        }
+        else
+        {
+          appendUnicode(_unicode);
+        }
+        break;
+
+      // Numbers, true, false and null end with the next character, it is read again
+      case SCALAR:
+        if (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) || (c == '.') || (c == '-') || (c == '+') || (c == 'E'))
+        {
+          append(c);
+          break;
+        }
+        in--;
+        found = endValue(((text()[0] >= 'a') && (text()[0] <= 'z')) ? LITERAL : NUMBER);
+        break;
+
+      case OBJECT:
+        if (c == '}')
+        {
+          found = endContainer(END_OBJECT, false);
+        }
+        else if (c == '"')
+        {
+          _keyLength = _length = 0;
+          _state = KEY;
+        }
+        else if (!isWhitespace(c))
+        {
+          _state = FAILED;
+        }
+        break;
+
+      case COLON:
+        if (c == ':')
+        {
+          _buffer[_keyLength] = '\x00';
+          selectKey();
+        }
+        break;
+
+      // The value of a key that was not selected
+      case SKIP_VALUE:
+        if ((c == '{') || (c == '['))
+        {
+          _skipDepth = _depth++;
+          _state = SKIP;
+        }
+        else if (c == '"')
+        {
+          _state = SKIP_STRING;
+        }
+        else if (!isWhitespace(c))
+        {
+          _state = SKIP_SCALAR;
+        }
+        break;
+
+      case VALUE:
+        _length = 0;
+        if ((_depth == 0) || inArray())
+        {
+          _keyLength = 0;
+          _field = 0;
+        }
+        _buffer[_keyLength] = '\x00';
+        if (c == '{')
+        {
+          found = beginContainer(BEGIN_OBJECT, false);
+        }
+        else if (c == '[')
+        {
+          found = beginContainer(BEGIN_ARRAY, true);
+        }
+        else if (c == ']')
+        {
+          // Empty array
+          found = endContainer(END_ARRAY, true);
+        }
+        else if (c == '"')
+        {
+          _state = STRING_VALUE;
+        }
+        else if (((c >= '0') && (c <= '9')) || (c == '-') || (c == 't') || (c == 'f') || (c == 'n'))
+        {
+          append(c);
+          _state = SCALAR;
+        }
+        else if (!isWhitespace(c))
+        {
+          _state = FAILED;
+        }
+        break;
+
+      case AFTER_VALUE:
+        if (c == ',')
+        {
+          _state = inArray() ? VALUE : OBJECT;
+        }
+        else if (c == '}')
+        {
+          found = endContainer(END_OBJECT, false);
+        }
+        else if (c == ']')
+        {
+          found = endContainer(END_ARRAY, true);
+        }
+        break;
+
+      // Done or failed, the rest is ignored
+      default:
+        in = end;
+        break;
+    }
+  }
+
+  _in = in;
+  return found;
+}
+
+/**
+  Copies the plain characters of a key or string value up to the closing
+  quote or an escape, these are left for next().
+*/
+inline const uint8_t *JsonTokenizer::copy(const uint8_t *in, const uint8_t *end)
+{
+  bool isKey = (_state == KEY);
+  char *out = isKey ? _buffer : _buffer + _keyLength + 1;
+  uint8_t length = isKey ? _keyLength : _length;
+  uint8_t max = isKey ? JSON_KEY_MAX - 1 : JSON_BUFFER_MAX - 2 - _keyLength;
+
+  while ((in < end) && (*in != '"') && (*in != '\\'))
+  {
+    if (length < max) out[length++] = *in;
+    in++;
+  }
+
+  if (isKey) _keyLength = length;
+  else _length = length;
+  return in;
+}
+
+/**
+  Passes over skipped input up to the end of the skipped part, only quotes,
+  escapes and brackets are looked at. Returns where it stopped.
+*/
+inline const uint8_t *JsonTokenizer::scan(const uint8_t *in, const uint8_t *end)
+{
+  State state = _state;
+  uint8_t depth = _depth;
+
+  while ((in < end) && (state >= SKIP))
+  {
+    switch (state)
+    {
+      case SKIP:
+        while ((in < end) && (*in != '"') && (*in != '{') && (*in != '[') && (*in != '}') && (*in != ']')) in++;
+        if (in == end) break;
+        if (*in == '"')
+        {
+          state = SKIP_STRING;
+        }
+        else if ((*in == '{') || (*in == '['))
+        {
+          depth++;
+        }
+        else if (--depth == _skipDepth)
+        {
+          _skipDepth = 0xFF;
+          state = (depth == 0) ? DONE : AFTER_VALUE;
+        }
+        in++;
+        break;
+
+      case SKIP_STRING:
+        while ((in < end) && (*in != '"') && (*in != '\\')) in++;
+        if (in == end) break;
+        if (*in == '"') state = (_skipDepth == 0xFF) ? AFTER_VALUE : SKIP;
+        else state = SKIP_ESCAPE;
+        in++;
+        break;
+
+      case SKIP_ESCAPE:
+        state = SKIP_STRING;
+        in++;
+        break;
+
+      // A number or literal ends with the next character, it is read again
+      default:
+        while ((in < end) && (*in != ',') && (*in != '}') && (*in != ']') && !isWhitespace(*in)) in++;
+        if (in < end) state = AFTER_VALUE;
+        break;
+    }
+  }
+
+  _state = state;
+  _depth = depth;
+  return in;
+}
+
+/**
+  Passes over the object or array of the current BEGIN token, the next token
+  is the one after its end. Does nothing for other tokens.
+*/
+inline void JsonTokenizer::skip()
+{
+  if ((_type != BEGIN_OBJECT) && (_type != BEGIN_ARRAY)) return;
+  _skipDepth = _tokenDepth;
+  _state = SKIP;
+}
+
+/**
+  Passes over the rest of the object or array that was begun at depth and
+  encloses the current token, e.g. skipRest(depth() - 1) after a value.
+*/
+inline void JsonTokenizer::skipRest(uint8_t depth)
+{
+  if ((depth >= _depth) || (_state == DONE) || (_state == FAILED)) return;
+  _skipDepth = depth;
+  _state = SKIP;
+}
+
+/**
+  Only values of these keys are returned, the list ends with NULL and holds
+  at most JSON_SELECT_MAX keys. field() tells which key of the list the value
+  has. Values in arrays are always returned. NULL returns all values again.
+  Stays set until reset().
+*/
+inline void JsonTokenizer::select(const char * const *keys)
+{
+  _keys = keys;
+  memset(_slots, 0, sizeof(_slots));
+  for (uint8_t i = 0; keys && keys[i] && (i < JSON_SELECT_MAX); i++)
+  {
+    uint8_t slot = hash(keys[i], min(strlen(keys[i]), (size_t)JSON_KEY_MAX - 1));
+    while (_slots[slot]) slot = (slot + 1) % JSON_SELECT_SLOTS;
+    _slots[slot] = i + 1;
+  }
+}
+
+/**
+  Looks the completed key up in the hash table of the selected keys, the
+  search ends at the first free slot.
+*/
+inline void JsonTokenizer::selectKey()
+{
+  _state = VALUE;
+  _field = 0;
+  if (!_keys) return;
+
+  for (uint8_t slot = hash(_buffer, _keyLength); _slots[slot]; slot = (slot + 1) % JSON_SELECT_SLOTS)
+  {
+    if (strcmp(_buffer, _keys[_slots[slot] - 1]) == 0)
+    {
+      _field = _slots[slot];
+      return;
+    }
+  }
+  _state = SKIP_VALUE;
+}
+
+// Length, first and last character of a key, as cut off in the buffer
+inline uint8_t JsonTokenizer::hash(const char *key, uint8_t length)
+{
+  if (length == 0) return 0;
+  return (length * 7 + key[0] * 3 + key[length - 1]) % JSON_SELECT_SLOTS;
+}
+
+// Completes a token
+inline bool JsonTokenizer::token(Type type)
+{
+  _type = type;
+  _buffer[_keyLength + 1 + _length] = '\x00';
+  return true;
+}
+
+inline bool JsonTokenizer::beginContainer(Type type, bool array)
+{
+  if (_depth == JSON_DEPTH_MAX)
+  {
+    _state = FAILED;
+    return false;
+  }
+  _tokenDepth = _depth;
+  if (array) _arrays |= (1UL << _depth);
+  else _arrays &= ~(1UL << _depth);
+  _depth++;
+  _state = array ? VALUE : OBJECT;
+  return token(type);
+}
+
+inline bool JsonTokenizer::endContainer(Type type, bool array)
+{
+  if ((_depth == 0) || (inArray() != array))
+  {
+    _state = FAILED;
+    return false;
+  }
+  _depth--;
+  _keyLength = _length = 0;
+  _field = 0;
+  _buffer[0] = '\x00';
+  return endValue(type);
+}
+
+// A complete value ends the document on the top level
+inline bool JsonTokenizer::endValue(Type type)
+{
+  _state = (_depth == 0) ? DONE : AFTER_VALUE;
+  _tokenDepth = _depth;
+  return token(type);
+}
+
+inline void JsonTokenizer::append(char c)
+{
+  if (_state == KEY)
+  {
+    if (_keyLength < JSON_KEY_MAX - 1) _buffer[_keyLength++] = c;
+  }
+  else if (_keyLength + 1 + _length < JSON_BUFFER_MAX - 1)
+  {
+    _buffer[_keyLength + 1 + _length++] = c;
+  }
+}
+
+// UTF-8 of a code point from a \u escape
+inline void JsonTokenizer::appendUnicode(uint32_t code)
+{
+  if (code < 0x80)
+  {
+    append(code);
+  }
+  else if (code < 0x800)
+  {
+    append(0xC0 | (code >> 6));
+    append(0x80 | (code & 0x3F));
+  }
+  else if (code < 0x10000)
+  {
+    append(0xE0 | (code >> 12));
+    append(0x80 | ((code >> 6) & 0x3F));
+    append(0x80 | (code & 0x3F));
+  }
+  else
+  {
+    append(0xF0 | (code >> 18));
+    append(0x80 | ((code >> 12) & 0x3F));
+    append(0x80 | ((code >> 6) & 0x3F));
+    append(0x80 | (code & 0x3F));
+  }
+}
+
+#endif
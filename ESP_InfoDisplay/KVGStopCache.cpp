@@ -0,0 +1,197 @@
+/**
+  KVG departure cache
+  Name: KVGStopCache.cpp
+  Purpose: Keeps the departures of several KVG stops, refreshed one stop at a time
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#include "Arduino.h"
+#include "KVGStopCache.h"
+
+// Public functions
+
+KVGStopCache::KVGStopCache(KVGliveAPI& api): _api(api)
+{
+}
+
+/**
+  Adds a stop to the cache, returns its index or -1 if the cache is full.
+*/
+int KVGStopCache::addStop(int stopNr)
+{
+  if (_count == KVG_CACHE_STOPS) return -1;
+  _entries[_count].stopNr = stopNr;
+  _entries[_count].fetched = 0;
+  _entries[_count].valid = false;
+  _entries[_count].stale = false;
+  _entries[_count].validator = HttpValidator();
+  _entries[_count].hash = 0;
+  _entries[_count].changes = 0;
+  return _count++;
+}
+
+uint8_t KVGStopCache::count()
+{
+  return _count;
+}
+
+/**
+  Starts the query of one stop, update() does the work.
+*/
+bool KVGStopCache::refresh(uint8_t index)
+{
+  if ((index >= _count) || busy()) return false;
+
+  // Keep the stop name, it is sent after the departures
+  _received.stopName = _entries[index].stop.stopName;
+  if (!_api.beginQuery(_entries[index].stopNr, _received, &_entries[index].validator)) return false;
+  _loading = index;
+  return true;
+}
+
+/**
+  Starts the query of the stops one after the other, one stop per call. Stops
+  that have never been read successfully are queried first.
+*/
+bool KVGStopCache::refreshNext()
+{
+  if (_count == 0) return false;
+  
+  uint8_t index = _next;
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    if (!_entries[i].valid) { index = i; break; }
+  }
+  _next = (index + 1) % _count;
+  return refresh(index);
+}
+
+/**
+  Continues the running query for at most budget ms. The departures are taken
+  over when the query is complete, a failed query keeps the previous ones.
+  Returns true when new departures were stored, not if the server answered
+  "not modified" or sent the same departures again. Both still restart the
+  count down of the minutes.
+*/
+bool KVGStopCache::update(uint32_t budget)
+{
+  if (_loading < 0) return false;
+  
+  HttpFetch::State state = _api.update(budget);
+  if (_api.busy()) return false;
+
+  Entry &e = _entries[_loading];
+  _loading = -1;
+  if (state != HttpFetch::DONE) return false;
+  if (e.stale)
+  {
+    e.stale = false;
+    e.changes++;
+  }
+  // "Not modified" and departures with the same hash both mean the server
+  // reports the stored minutes as of now, the hash covers them. So the count
+  // down starts again from now in both cases.
+  e.fetched = millis();
+  e.valid = true;
+  if (_api.notModified()) return false;
+  uint32_t hash = _api.contentHash();
+  if (hash == e.hash) return false;
+  e.stop = _received;
+  e.hash = hash;
+  e.changes++;
+  return true;
+}
+
+bool KVGStopCache::busy()
+{
+  return (_loading >= 0);
+}
+
+bool KVGStopCache::isValid(uint8_t index)
+{
+  return (index < _count) && _entries[index].valid;
+}
+
+bool KVGStopCache::isStale(uint8_t index)
+{
+  return isValid(index) && _entries[index].stale;
+}
+
+int KVGStopCache::stopNumber(uint8_t index)
+{
+  return (index < _count) ? _entries[index].stopNr : -1;
+}
+
+/**
+  Takes over departures saved before the restart. They are shown as stale
+  and counted down from now until the stop is read again.
+*/
+bool KVGStopCache::restore(uint8_t index, const KVGbusStop& stop)
+{
+  if ((index >= _count) || _entries[index].valid) return false;
+  Entry &e = _entries[index];
+  e.stop = stop;
+  e.fetched = millis();
+  e.valid = true;
+  e.stale = true;
+  e.hash = 0;
+  e.changes++;
+  return true;
+}
+
+/**
+  Milliseconds since the stop was read.
+*/
+uint32_t KVGStopCache::age(uint8_t index)
+{
+  if (!isValid(index)) return 0xFFFFFFFF;
+  return millis() - _entries[index].fetched;
+}
+
+/**
+  Changes whenever readBusStop() may return something else: new departures,
+  the end of stale, or one more minute counted down. The display is redrawn
+  only if the version differs from the one shown.
+*/
+uint32_t KVGStopCache::version(uint8_t index)
+{
+  if (!isValid(index)) return 0xFFFFFFFF;
+  return ((uint32_t)_entries[index].changes << 16) | min(age(index) / 60000, (uint32_t)0xFFFF);
+}
+
+/**
+  Departures of a stop as of now. The minutes of predicted departures are
+  counted down by the age of the entry and buses that have left are removed.
+*/
+const KVGbusStop& KVGStopCache::readBusStop(uint8_t index)
+{
+  if (index >= _count) return _view;
+  Entry &e = _entries[index];
+  int8_t elapsed = min(age(index) / 60000, (uint32_t)127);
+  
+  _view.stopName = e.stop.stopName;
+  uint8_t row = 0;
+  for (uint8_t i = 0; i < KVG_DEPARTURES; i++)
+  {
+    KVGbus bus = e.stop.departures[i];
+    if (bus.number.length() == 0) continue;
+    // Planned departures (-2) show the time of day and do not count down
+    if (bus.depMinutes >= 0)
+    {
+      if (bus.depMinutes < elapsed) continue;
+      bus.depMinutes -= elapsed;
+    }
+    _view.departures[row++] = bus;
+  }
+  for (; row < KVG_DEPARTURES; row++)
+  {
+    _view.departures[row].number = String();
+    _view.departures[row].dir = String();
+    _view.departures[row].depTime = String();
+    _view.departures[row].depMinutes = 0;
+    _view.departures[row].depDelay = 0;
+  }
+  return _view;
+}
@@ -0,0 +1,57 @@
+/**
+  KVG departure cache Header
+  Name: KVGStopCache.h
+  Purpose: Keeps the departures of several KVG stops, refreshed one stop at a time
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#ifndef KVGStopCache_h
+#define KVGStopCache_h
+
+#define KVG_CACHE_STOPS 4         // Maximum number of stops in the cache
+
+#include "Arduino.h"
+#include "KVGliveAPI.h"
+
+class KVGStopCache
+{
+  public:
+    KVGStopCache(KVGliveAPI& api);
+    int addStop(int stopNr);
+    uint8_t count();
+    bool refresh(uint8_t index);
+    bool refreshNext();
+    bool update(uint32_t budget);
+    bool busy();
+    bool isValid(uint8_t index);
+    bool isStale(uint8_t index);
+    int stopNumber(uint8_t index);
+    bool restore(uint8_t index, const KVGbusStop& stop);
+    uint32_t age(uint8_t index);
+    uint32_t version(uint8_t index);
+    const KVGbusStop& readBusStop(uint8_t index);
+
+  private:
+    struct Entry
+    {
+      int stopNr;
+      KVGbusStop stop;            // Departures as received
+      uint32_t fetched;           // millis() of the last successful query
+      bool valid;
+      bool stale;                 // Restored from the snapshot, not read since the start
+      HttpValidator validator;    // Of the last response, for a conditional query
+      uint32_t hash;              // Content hash of the departures, 0 if not known
+      uint16_t changes;           // Counts the changes of the departures and of stale
+    };
+    Entry _entries[KVG_CACHE_STOPS];
+    uint8_t _count = 0;
+    uint8_t _next = 0;            // Next stop for refreshNext()
+    int8_t _loading = -1;         // Stop being queried
+    KVGbusStop _received;         // Departures of the running query
+    KVGbusStop _view;             // Aged copy returned by readBusStop()
+    KVGliveAPI& _api;
+};
+
+#endif
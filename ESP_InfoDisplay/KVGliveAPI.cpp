@@ -12,31 +12,107 @@
 
 // Public functions
 
-KVGliveAPI::KVGliveAPI(HTTPClient& http): _http(http)
+KVGliveAPI::KVGliveAPI()
 {
 }
 
+/**
+  Reads the departures from the gateway on host instead of KVG. The gateway
+  sends the six departures as a record, tools/host/gateway.cpp.
+*/
+void KVGliveAPI::useGateway(const char* host, uint16_t port)
+{
+  _gatewayHost = host;
+  _gatewayPort = port;
+}
+
+/**
+  Path of the KVG query for stopNr.
+*/
+String KVGliveAPI::queryPath(int stopNr)
+{
+  return String(apiLink) + String(stopNr);
+}
+
+/**
+  Reads the departures of stopNr and waits until they are received.
+*/
 bool KVGliveAPI::queryBusStop(int stopNr)
 {
-  String apiAddress = String(apiLink) + String(stopNr);
+  // The stop name is sent after the departures, keep it to stop reading early
+  if (stopNr != _stopNr) _actualStop.stopName = String();
+  _stopNr = stopNr;
 
-  _http.begin(apiAddress);
-  
-  // start connection and send HTTP header
-  int httpCode = _http.GET();
+  if (!beginQuery(stopNr, _actualStop)) return false;
+  while (busy()) update(100);
+  return (_fetch.state() == HttpFetch::DONE);
+}
 
-  // httpCode will be negative on error
-  if(httpCode > 0) 
+/**
+  Starts reading the departures of stopNr into busStop, update() does the
+  work. The stop name of busStop is kept, so busStop must be empty or hold an
+  earlier result of the same stop. With the validator of the last query of
+  the stop, busStop is left alone if the server answers the departures did
+  not change, see notModified().
+*/
+bool KVGliveAPI::beginQuery(int stopNr, KVGbusStop &busStop, HttpValidator *validator)
+{
+  if (_gatewayHost)
   {
-    // file found at server
-    if(httpCode == HTTP_CODE_OK) 
-    {
-      payload = _http.getString();
-      // Read JSON String and write values into "actualStop"
-      _actualStop = parseKVGbusString(payload);
-    }        
+    if (!_fetch.begin(_client, _gatewayHost, _gatewayPort, "/stop/" + String(stopNr), &_record, KVG_QUERY_TIMEOUT, validator)) return false;
+    _record.begin();
+    _busStop = &busStop;
+    return true;
+  }
+  listener.begin(&busStop);
+  return _fetch.begin(_client, apiHost, 80, queryPath(stopNr), &listener, KVG_QUERY_TIMEOUT, validator);
+}
+
+/**
+  Continues the running query for at most budget ms. Returns DONE once the
+  departures are complete, FAILED if the query broke off.
+*/
+HttpFetch::State KVGliveAPI::update(uint32_t budget)
+{
+  if (!busy()) return _fetch.state();
+  
+  _fetch.update(budget);
+  // Nothing was received, busStop is as before
+  if (notModified()) return _fetch.state();
+  if (_gatewayHost)
+  {
+    // A broken record counts as a failed query
+    if ((_fetch.state() == HttpFetch::DONE) && !_record.readBusStop(*_busStop)) _fetch.abort();
+    return _fetch.state();
   }
-  return (httpCode == HTTP_CODE_OK);
+  // No need to read the rest of the response
+  if (busy() && listener.isComplete()) _fetch.finish();
+  // Clear the rows that were not in the response
+  if (!busy()) listener.finish();
+
+  return _fetch.state();
+}
+
+bool KVGliveAPI::busy()
+{
+  return _fetch.busy();
+}
+
+/**
+  True if the last query is DONE because the server answered that the
+  departures did not change since the validator passed to beginQuery().
+*/
+bool KVGliveAPI::notModified()
+{
+  return _fetch.notModified();
+}
+
+/**
+  Hash of the departures of the last query, equal if they did not change.
+*/
+uint32_t KVGliveAPI::contentHash()
+{
+  return _gatewayHost ? _record.hash() : listener.contentHash();
 }
 
 KVGbusStop KVGliveAPI::readBusStop()
@@ -61,76 +137,3 @@ String KVGliveAPI::printBusStop()
   return busStr;
 }
 
-// Private functions
-
-KVGbusStop KVGliveAPI::parseKVGbusString(String jsonStr)
-{
-  KVGbusStop newStop;
-
-  // use large buffer for json decoding (2000 should have been enough for normal bus stops)
-  const size_t bufferSize = 10000;
-  DynamicJsonBuffer jsonBuffer(bufferSize);
-
-  // parse JSON return from KVG
-  JsonObject& root = jsonBuffer.parseObject(jsonStr);
-
-  // fetch array with bus departures
-  JsonArray& actual = root["actual"];
-  // Read name of bus stop
-  newStop.stopName = root["stopName"].as<String>();
-  
-  uint16_t row = 0;          
-
-  // iterate through bus departure array and print each line to tft
-  for(JsonArray::iterator it=actual.begin(); it!=actual.end(); ++it) 
-  {
-      JsonObject& actual0 = *it;
-      // Fill values into BusStop struct
-      if (row < 6) 
-      {
-          newStop.departures[row].number = actual0["patternText"].as<String>();
-          newStop.departures[row].dir = actual0["direction"].as<String>();
-          newStop.departures[row].depTime = actual0["plannedTime"].as<String>();
-          //const char* actual_status = actual0["status"]; // "PREDICTED"
-          //Serial.println(actual_status);
-          if (strcmp(actual0["status"],"PREDICTED") == 0) 
-          {
-            uint8_t len = strlen(actual0["mixedTime"]);
-            char minLeft[6];
-            strncpy (minLeft,actual0["mixedTime"],len-11);
-            newStop.departures[row].depMinutes = atoi(minLeft);
-            newStop.departures[row].depDelay = calcDelay(actual0["plannedTime"],actual0["actualTime"]);
-          }
-          else
-          {
-            newStop.departures[row].depMinutes = -2;
-            newStop.departures[row].depDelay = 0;
-          }
-      }
-      row++;
-  }
-  for (row; row < 6; row++)
-  {
-      newStop.departures[row].number = String();
-      newStop.departures[row].dir = String();
-      newStop.departures[row].depTime = String();
-      newStop.departures[row].depMinutes = 0;
-      newStop.departures[row].depDelay = 0;
-  }
-  return newStop;
-}
-
-int KVGliveAPI::calcDelay(const char* planned, const char* actual)
-{
-  char plH[3], plM[3], acH[3], acM[3];
-  plH[0] = planned[0];plH[1] = planned[1];
-  plM[0] = planned[3];plM[1] = planned[4];
-  acH[0] = actual[0];acH[1] = actual[1];
-  acM[0] = actual[3];acM[1] = actual[4];
-  plH[2] = plM[2] = acH[2] = acM[2] = '\x00';
-  uint16_t tP = 60 * atoi(plH) + atoi(plM);   
-  uint16_t tA = 60 * atoi(acH) + atoi(acM);   
-  return tA - tP;
-}
-
-
@@ -10,37 +10,33 @@
 #ifndef KVGliveAPI_h
 #define KVGliveAPI_h
 
+#define KVG_QUERY_TIMEOUT 5000    // Give up if a query takes longer than 5s
+
 #include "Arduino.h"
 #include <String.h>
-// JSON parser library
-#include <ArduinoJson.h>
+// Data Listener for JSON parser library
+#include "KVGliveAPI_DataListener.h"
 // WIFI connection for ESP8266
 #include <ESP8266WiFi.h>
-#include <ESP8266HTTPClient.h>
-
-typedef struct KVGbus 
-{
-  String number;
-  String dir;
-  String depTime;
-  int8_t depMinutes;
-  int8_t depDelay;
-};
-
-typedef struct KVGbusStop
-{
-  String stopName;
-  KVGbus departures[6];
-};
+// Non-blocking HTTP requests
+#include "HttpFetch.h"
+// Departure records of the gateway
+#include "GatewayRecord.h"
 
 class KVGliveAPI
 {
   public:
-    KVGliveAPI(HTTPClient& http);
+    KVGliveAPI();
+    void useGateway(const char* host, uint16_t port);
+    String queryPath(int stopNr);
     bool queryBusStop(int stopNr);
+    bool beginQuery(int stopNr, KVGbusStop &busStop, HttpValidator *validator = NULL);
+    HttpFetch::State update(uint32_t budget);
+    bool busy();
+    bool notModified();
+    uint32_t contentHash();
     KVGbusStop readBusStop();
     String printBusStop();
-    String payload;
   	struct KVGstop
   	{
   		static const int Wrangelstrasse = 105;
@@ -63,11 +59,17 @@ class KVGliveAPI
   	};
 	
   private:
-    KVGbusStop parseKVGbusString(String jsonStr);
-  	int calcDelay(const char* planned, const char* actual);
-  	const char* apiLink = "http://kvg-kiel.de/internetservice/services/passageInfo/stopPassages/stop?mode=departure&stop=";
+    HttpFetch _fetch;
+    WiFiClient _client;
+    KVGDataListener listener;
+    GatewayRecord _record;
+    KVGbusStop *_busStop = NULL;  // Filled by the running query
+    const char* _gatewayHost = NULL;  // NULL to query KVG directly
+    uint16_t _gatewayPort;
+    int _stopNr = 0;
+  	const char* apiHost = "kvg-kiel.de";
+  	const char* apiLink = "/internetservice/services/passageInfo/stopPassages/stop?mode=departure&stop=";
 	KVGbusStop _actualStop;
-  	HTTPClient& _http;
 };
 
 #endif
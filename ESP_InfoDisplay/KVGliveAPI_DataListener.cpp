@@ -0,0 +1,163 @@
+/**
+  KVG live Data Listener Library
+  Name: KVGliveAPI_DataListener.cpp
+  Purpose: Reads the tokens of a KVG response, fills a KVGbusStop while streaming
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#include "Arduino.h"
+#include "KVGliveAPI_DataListener.h"
+
+#define PARSER_DEBUG false  //Set to true to view parsed data via serial output. WARNING: may cause major latency if baud rate is low!
+
+/**
+  Starts filling busStop. The stop name is kept, it does not change between
+  queries of the same stop.
+*/
+void KVGDataListener::begin(KVGbusStop *busStop) {
+  stop = busStop;
+  row = 0;
+  hash = FNV1A_BASIS;
+  inActual = inDeparture = false;
+}
+
+/**
+  True as soon as all departures and the stop name are known, the rest of the
+  response does not need to be read.
+*/
+bool KVGDataListener::isComplete() {
+  return (row >= KVG_DEPARTURES) && (stop->stopName.length() > 0);
+}
+
+/**
+  Hash of the departure values read. The response itself differs from second
+  to second, it holds the departure times relative to now.
+*/
+uint32_t KVGDataListener::contentHash() {
+  return hash;
+}
+
+/**
+  Clears the departure rows that were not in the response.
+*/
+void KVGDataListener::finish() {
+  for (; row < KVG_DEPARTURES; row++)
+  {
+    stop->departures[row].number = String();
+    stop->departures[row].dir = String();
+    stop->departures[row].depTime = String();
+    stop->departures[row].depMinutes = 0;
+    stop->departures[row].depDelay = 0;
+  }
+}
+
+/**
+  Takes the tokens of the received piece. Only the stop name and the first
+  departures of "actual" are read, the other arrays and the departures that
+  are not shown are skipped.
+*/
+void KVGDataListener::parse(JsonTokenizer &json) {
+  while(json.next())
+  {
+    if(PARSER_DEBUG) Serial.println(String(json.type()) + " " + json.key() + ": " + json.text());
+
+    switch(json.type())
+    {
+      case JsonTokenizer::BEGIN_ARRAY:
+        if((json.depth() == 1) && json.isKey("actual")) inActual = true;
+        else json.skip();
+        break;
+
+      case JsonTokenizer::BEGIN_OBJECT:
+        if(inActual && (json.depth() == 2) && (row < KVG_DEPARTURES))
+        {
+          inDeparture = true;
+          predicted = false;
+          minutes = 0;
+          memset(plannedTime, 0, sizeof(plannedTime));
+          memset(actualTime, 0, sizeof(actualTime));
+        }
+        else if(json.depth() > 0) json.skip();
+        break;
+
+      case JsonTokenizer::END_ARRAY:
+        if(json.depth() == 1) inActual = false;
+        break;
+
+      case JsonTokenizer::END_OBJECT:
+        if(inDeparture && (json.depth() == 2)) endDeparture();
+        break;
+
+      default:
+        value(json);
+        break;
+    }
+  }
+}
+
+void KVGDataListener::value(JsonTokenizer &json) {
+  if((json.depth() == 1) && json.isKey("stopName"))
+    stop->stopName = json.text();
+
+  if(inDeparture && (json.depth() == 3))
+  {
+    KVGbus &bus = stop->departures[row];
+    
+    if(json.isKey("patternText"))
+      bus.number = json.text();
+
+    else if(json.isKey("direction"))
+      bus.dir = json.text();
+
+    else if(json.isKey("plannedTime"))
+    {
+      bus.depTime = json.text();
+      strncpy(plannedTime, json.text(), sizeof(plannedTime) - 1);
+    }
+
+    else if(json.isKey("actualTime"))
+      strncpy(actualTime, json.text(), sizeof(actualTime) - 1);
+
+    // "5 %UNIT_MIN%" for predicted departures
+    else if(json.isKey("mixedTime"))
+      minutes = atoi(json.text());
+
+    else if(json.isKey("status"))
+      predicted = json.isText("PREDICTED");
+
+    else return;
+
+    // With the terminating zero, so that "a","bc" and "ab","c" differ
+    hash = fnv1a(hash, json.text(), json.length() + 1);
+  }
+}
+
+void KVGDataListener::endDeparture() {
+  inDeparture = false;
+  if(predicted)
+  {
+    stop->departures[row].depMinutes = minutes;
+    stop->departures[row].depDelay = calcDelay(plannedTime, actualTime);
+  }
+  else
+  {
+    stop->departures[row].depMinutes = -2;
+    stop->departures[row].depDelay = 0;
+  }
+  row++;
+}
+
+int KVGDataListener::calcDelay(const char* planned, const char* actual)
+{
+  char plH[3], plM[3], acH[3], acM[3];
+  plH[0] = planned[0];plH[1] = planned[1];
+  plM[0] = planned[3];plM[1] = planned[4];
+  acH[0] = actual[0];acH[1] = actual[1];
+  acM[0] = actual[3];acM[1] = actual[4];
+  plH[2] = plM[2] = acH[2] = acM[2] = '\x00';
+  uint16_t tP = 60 * atoi(plH) + atoi(plM);   
+  uint16_t tA = 60 * atoi(acH) + atoi(acM);   
+  return tA - tP;
+}
@@ -0,0 +1,53 @@
+/**
+  KVG live Data Listener Library Header
+  Name: KVGliveAPI_DataListener.h
+  Purpose: Reads the tokens of a KVG response, fills a KVGbusStop while streaming
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#pragma once
+
+#include "HttpFetch.h"
+
+#define KVG_DEPARTURES 6
+
+typedef struct KVGbus 
+{
+  String number;
+  String dir;
+  String depTime;
+  int8_t depMinutes;
+  int8_t depDelay;
+};
+
+typedef struct KVGbusStop
+{
+  String stopName;
+  KVGbus departures[KVG_DEPARTURES];
+};
+
+class KVGDataListener: public JsonHandler {
+
+  private:
+    KVGbusStop *stop = NULL;
+    uint8_t row = 0;
+    bool inActual = false;        // Inside the "actual" departure array
+    bool inDeparture = false;     // Inside one departure object
+    bool predicted = false;
+    int8_t minutes = 0;
+    char plannedTime[6];          // "hh:mm"
+    char actualTime[6];
+    uint32_t hash;                // fnv1a() of the departure values read
+    void value(JsonTokenizer &json);
+    void endDeparture();
+    int calcDelay(const char* planned, const char* actual);
+
+  public:
+    void begin(KVGbusStop *busStop);
+    bool isComplete();
+    uint32_t contentHash();
+    void finish();
+    virtual void parse(JsonTokenizer &json);
+};
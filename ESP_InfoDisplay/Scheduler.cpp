@@ -0,0 +1,150 @@
+/**
+  Cooperative task scheduler
+  Name: Scheduler.cpp
+  Purpose: Runs periodic and one-shot tasks by priority from the main loop (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#include "Arduino.h"
+#include "Scheduler.h"
+
+/**
+  Adds a task and returns its id, -1 if there is no room. Periodic tasks run
+  first after interval, one-shot tasks wait for runIn() or trigger().
+*/
+int8_t Scheduler::add(TaskCallback cb, uint32_t interval, uint8_t priority, bool periodic)
+{
+  if (_count == SCHEDULER_TASKS) return -1;
+  Task &t = _tasks[_count];
+  t.cb = cb;
+  t.interval = interval;
+  t.due = millis() + interval;
+  t.runTime = t.maxRunTime = t.runs = 0;
+  t.priority = priority;
+  t.periodic = periodic;
+  t.armed = periodic;
+  return _count++;
+}
+
+/**
+  Runs a task once after delay ms, periodic tasks continue from there.
+*/
+void Scheduler::runIn(int8_t id, uint32_t delay)
+{
+  if ((id < 0) || (id >= _count)) return;
+  _tasks[id].due = millis() + delay;
+  _tasks[id].armed = true;
+}
+
+/**
+  Runs a task as soon as possible. Safe to call from an interrupt, so it is
+  kept in RAM.
+*/
+ICACHE_RAM_ATTR void Scheduler::trigger(int8_t id)
+{
+  if ((id < 0) || (id >= _count)) return;
+  _pending |= (1 << id);
+}
+
+void Scheduler::stop(int8_t id)
+{
+  if ((id < 0) || (id >= _count)) return;
+  _tasks[id].armed = false;
+}
+
+/**
+  Runs the due task with the highest priority. Returns the time in ms until
+  the next task is due, 0 if more tasks are waiting.
+*/
+uint32_t Scheduler::run()
+{
+  uint32_t now = millis();
+  int8_t next = -1;
+
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    Task &t = _tasks[i];
+    // Deadlines are compared as a signed difference, this works across the millis() wrap
+    bool due = (_pending & (1 << i)) || (t.armed && ((int32_t)(now - t.due) >= 0));
+    if (!due) continue;
+    if ((next < 0) || (t.priority > _tasks[next].priority)) next = i;
+  }
+
+  if (next >= 0)
+  {
+    Task &t = _tasks[next];
+    noInterrupts();
+    _pending &= ~(1 << next);
+    interrupts();
+
+    if (t.periodic)
+    {
+      t.due += t.interval;
+      // Missed periods are skipped instead of run in a burst
+      if ((int32_t)(now - t.due) >= 0) t.due = now + t.interval;
+    }
+    else
+    {
+      t.armed = false;
+    }
+
+    uint32_t start = micros();
+    t.cb();
+    uint32_t took = micros() - start;
+    t.runTime += took;
+    if (took > t.maxRunTime) t.maxRunTime = took;
+    t.runs++;
+    return 0;
+  }
+
+  // Time until the next deadline
+  uint32_t wait = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    Task &t = _tasks[i];
+    if (t.armed && (t.due - now < wait)) wait = t.due - now;
+  }
+  return wait;
+}
+
+/**
+  Waits up to maxTime ms or until a task is triggered. delay() hands the time
+  to the SDK which lets the CPU idle and the WiFi modem sleep.
+*/
+void Scheduler::idle(uint32_t maxTime)
+{
+  uint32_t start = millis();
+  while ((_pending == 0) && (millis() - start < maxTime)) delay(1);
+}
+
+/**
+  Total run time of a task in µs.
+*/
+uint32_t Scheduler::runTime(int8_t id)
+{
+  return ((id >= 0) && (id < _count)) ? _tasks[id].runTime : 0;
+}
+
+/**
+  Longest run of a task in µs.
+*/
+uint32_t Scheduler::maxRunTime(int8_t id)
+{
+  return ((id >= 0) && (id < _count)) ? _tasks[id].maxRunTime : 0;
+}
+
+uint32_t Scheduler::runCount(int8_t id)
+{
+  return ((id >= 0) && (id < _count)) ? _tasks[id].runs : 0;
+}
+
+void Scheduler::printStats(Print &out)
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    out.println("Task " + String(i) + ": " + String(_tasks[i].runs) + " runs, " + 
+                String(_tasks[i].runTime / 1000) + " ms total, " + String(_tasks[i].maxRunTime) + " us max");
+  }
+}
@@ -0,0 +1,51 @@
+/**
+  Cooperative task scheduler Header
+  Name: Scheduler.h
+  Purpose: Runs periodic and one-shot tasks by priority from the main loop (For ESP8266)
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#ifndef Scheduler_h
+#define Scheduler_h
+
+#define SCHEDULER_TASKS 8         // Maximum number of tasks
+
+#include "Arduino.h"
+
+typedef void (*TaskCallback)(void);
+
+class Scheduler
+{
+  public:
+    int8_t add(TaskCallback cb, uint32_t interval, uint8_t priority, bool periodic = true);
+    void runIn(int8_t id, uint32_t delay);
+    void trigger(int8_t id);
+    void stop(int8_t id);
+    uint32_t run();
+    void idle(uint32_t maxTime);
+    uint32_t runTime(int8_t id);
+    uint32_t maxRunTime(int8_t id);
+    uint32_t runCount(int8_t id);
+    void printStats(Print &out);
+
+  private:
+    struct Task
+    {
+      TaskCallback cb;
+      uint32_t interval;          // ms, 0 for tasks that only run when triggered
+      uint32_t due;               // millis() of the next run
+      uint32_t runTime;           // Total run time in µs
+      uint32_t maxRunTime;        // Longest run in µs
+      uint32_t runs;
+      uint8_t priority;           // Higher runs first
+      bool periodic;
+      bool armed;
+    };
+    Task _tasks[SCHEDULER_TASKS];
+    uint8_t _count = 0;
+    volatile uint16_t _pending = 0; // Tasks triggered from an interrupt
+};
+
+#endif
@@ -0,0 +1,199 @@
+/**
+  Snapshot of the shown data
+  Name: Snapshot.cpp
+  Purpose: Saves the last forecast and departures to flash, so they can be shown right after a restart
+
+  @author basti8909
+  @version 1.0 16/08/17
+
+  The file is written in the byte order of the ESP8266:
+    "IDSN", version, stop count
+    forecast: icon, temperature, wind speed and direction, then the 48 hour
+              arrays of WeatherForecast
+    per stop: stop number, name and the departures, strings are stored with
+              a length byte in front
+  It is written to a temporary file first and renamed, so a restart while
+  saving keeps the previous snapshot.
+*/
+
+#include "Arduino.h"
+#include "Snapshot.h"
+
+static const char SNAPSHOT_MAGIC[4] = {'I', 'D', 'S', 'N'};
+
+// Public functions
+
+/**
+  Mounts the file system, returns false if there is none.
+*/
+bool Snapshot::begin()
+{
+  _mounted = SPIFFS.begin();
+  if (DEBUG_Snapshot && !_mounted) Serial.println("Snapshot: no file system");
+  return _mounted;
+}
+
+/**
+  Writes the snapshot to a temporary file that replaces the previous one.
+  If not all bytes could be written, e.g. on a full file system, the
+  temporary file is removed and the previous snapshot is kept.
+*/
+bool Snapshot::save(const WeatherForecast &weather, KVGStopCache &stops)
+{
+  if (!_mounted) return false;
+
+  File f = SPIFFS.open(SNAPSHOT_TMP_FILE, "w");
+  if (!f) return false;
+  _written = _expected = 0;
+
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < stops.count(); i++)
+    if (stops.isValid(i)) count++;
+
+  uint8_t header[] = {SNAPSHOT_VERSION, count, (uint8_t)weather.actIco};
+  write(f, SNAPSHOT_MAGIC, 4);
+  write(f, header, sizeof(header));
+  write(f, &weather.actTemp, sizeof(weather.actTemp));
+  write(f, &weather.actWindSpd, 1);
+  write(f, &weather.actWindDir, 1);
+  write(f, weather.fTemp, sizeof(weather.fTemp));
+  write(f, weather.fRainProb, sizeof(weather.fRainProb));
+  write(f, weather.fRainInt, sizeof(weather.fRainInt));
+  write(f, weather.fWindSpd, sizeof(weather.fWindSpd));
+  write(f, weather.fWindDir, sizeof(weather.fWindDir));
+  write(f, weather.fCloudCover, sizeof(weather.fCloudCover));
+
+  for (uint8_t i = 0; i < stops.count(); i++)
+  {
+    if (!stops.isValid(i)) continue;
+    int16_t stopNr = stops.stopNumber(i);
+    // Minutes counted down to now
+    const KVGbusStop &stop = stops.readBusStop(i);
+    write(f, &stopNr, sizeof(stopNr));
+    writeString(f, stop.stopName);
+    for (uint8_t row = 0; row < KVG_DEPARTURES; row++)
+    {
+      const KVGbus &bus = stop.departures[row];
+      writeString(f, bus.number);
+      writeString(f, bus.dir);
+      writeString(f, bus.depTime);
+      write(f, &bus.depMinutes, 1);
+      write(f, &bus.depDelay, 1);
+    }
+  }
+  f.close();
+
+  if (_written != _expected)
+  {
+    SPIFFS.remove(SNAPSHOT_TMP_FILE);
+    if (DEBUG_Snapshot) Serial.println("Snapshot: write failed");
+    return false;
+  }
+  SPIFFS.remove(SNAPSHOT_FILE);
+  bool ok = SPIFFS.rename(SNAPSHOT_TMP_FILE, SNAPSHOT_FILE);
+  if (DEBUG_Snapshot) Serial.println(ok ? "Snapshot saved" : "Snapshot: rename failed");
+  return ok;
+}
+
+/**
+  Reads the snapshot. The departures are given to the stops of the cache
+  with the same stop number. Returns false if there is no snapshot of this
+  version, then nothing is changed.
+*/
+bool Snapshot::load(WeatherForecast &weather, KVGStopCache &stops)
+{
+  if (!_mounted) return false;
+
+  File f = SPIFFS.open(SNAPSHOT_FILE, "r");
+  if (!f) return false;
+
+  char magic[4];
+  uint8_t header[2];
+  WeatherForecast w;
+  bool ok = (f.read((uint8_t *)magic, 4) == 4) && (memcmp(magic, SNAPSHOT_MAGIC, 4) == 0) &&
+            (f.read(header, 2) == 2) && (header[0] == SNAPSHOT_VERSION);
+
+  if (ok)
+  {
+    uint8_t ico[3];
+    ok = (f.read(ico, 1) == 1) &&
+         (f.read((uint8_t *)&w.actTemp, sizeof(w.actTemp)) == sizeof(w.actTemp)) &&
+         (f.read(ico + 1, 2) == 2) &&
+         (f.read((uint8_t *)w.fTemp, sizeof(w.fTemp)) == sizeof(w.fTemp)) &&
+         (f.read(w.fRainProb, sizeof(w.fRainProb)) == sizeof(w.fRainProb)) &&
+         (f.read(w.fRainInt, sizeof(w.fRainInt)) == sizeof(w.fRainInt)) &&
+         (f.read(w.fWindSpd, sizeof(w.fWindSpd)) == sizeof(w.fWindSpd)) &&
+         (f.read(w.fWindDir, sizeof(w.fWindDir)) == sizeof(w.fWindDir)) &&
+         (f.read(w.fCloudCover, sizeof(w.fCloudCover)) == sizeof(w.fCloudCover));
+    w.actIco = (WeatherIcon)ico[0];
+    w.actWindSpd = ico[1];
+    w.actWindDir = ico[2];
+    w.changed = WEATHER_CHANGED_ALL;
+  }
+
+  // Departures of stops that are no longer shown are skipped. The stops are
+  // given to the cache only when the whole file has been read.
+  KVGbusStop saved[KVG_CACHE_STOPS];
+  bool found[KVG_CACHE_STOPS] = {false};
+  for (uint8_t n = 0; ok && (n < header[1]); n++)
+  {
+    int16_t stopNr;
+    KVGbusStop stop;
+    ok = (f.read((uint8_t *)&stopNr, sizeof(stopNr)) == sizeof(stopNr)) && readString(f, stop.stopName);
+    for (uint8_t row = 0; ok && (row < KVG_DEPARTURES); row++)
+    {
+      KVGbus &bus = stop.departures[row];
+      uint8_t dep[2];
+      ok = readString(f, bus.number) && readString(f, bus.dir) && readString(f, bus.depTime) &&
+           (f.read(dep, 2) == 2);
+      bus.depMinutes = (int8_t)dep[0];
+      bus.depDelay = (int8_t)dep[1];
+    }
+    for (uint8_t i = 0; ok && (i < stops.count()); i++)
+    {
+      if (stops.stopNumber(i) != stopNr) continue;
+      saved[i] = stop;
+      found[i] = true;
+    }
+  }
+  f.close();
+
+  if (ok)
+  {
+    weather = w;
+    for (uint8_t i = 0; i < stops.count(); i++)
+      if (found[i]) stops.restore(i, saved[i]);
+  }
+  if (DEBUG_Snapshot) Serial.println(ok ? "Snapshot loaded" : "Snapshot: invalid");
+  return ok;
+}
+
+
+// Private functions
+
+/**
+  Writes to the file of save() and counts the bytes that were written.
+*/
+void Snapshot::write(File &f, const void *data, size_t length)
+{
+  _expected += length;
+  _written += f.write((const uint8_t *)data, length);
+}
+
+void Snapshot::writeString(File &f, const String &s)
+{
+  uint8_t len = min(s.length(), (unsigned int)255);
+  write(f, &len, 1);
+  write(f, s.c_str(), len);
+}
+
+bool Snapshot::readString(File &f, String &s)
+{
+  char buf[256];
+  uint8_t len;
+  if (f.read(&len, 1) != 1) return false;
+  if (f.read((uint8_t *)buf, len) != len) return false;
+  buf[len] = '\0';
+  s = buf;
+  return true;
+}
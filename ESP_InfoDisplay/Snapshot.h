@@ -0,0 +1,39 @@
+/**
+  Snapshot of the shown data Header
+  Name: Snapshot.h
+  Purpose: Saves the last forecast and departures to flash, so they can be shown right after a restart
+
+  @author basti8909
+  @version 1.0 16/08/17
+*/
+
+#ifndef Snapshot_h
+#define Snapshot_h
+
+#define DEBUG_Snapshot 0
+
+#define SNAPSHOT_FILE     "/snapshot.bin"
+#define SNAPSHOT_TMP_FILE "/snapshot.tmp"
+#define SNAPSHOT_VERSION  1       // Change when the layout of the file changes
+
+#include "Arduino.h"
+#include <FS.h>
+#include "DarkSkyAPI.h"
+#include "KVGStopCache.h"
+
+class Snapshot
+{
+  public:
+    bool begin();
+    bool save(const WeatherForecast &weather, KVGStopCache &stops);
+    bool load(WeatherForecast &weather, KVGStopCache &stops);
+
+  private:
+    void write(File &f, const void *data, size_t length);
+    void writeString(File &f, const String &s);
+    bool readString(File &f, String &s);
+    bool _mounted = false;
+    size_t _written, _expected;   // Bytes of the running save()
+};
+
+#endif
@@ -8,6 +8,8 @@
 */
 
 // Icons erstellen über http://www.digole.com/tools/PicturetoC_Hex_converter.php
+// Not included by the sketch, after changes convert to icons_rle.h with:
+//   python3 tools/xbm2rle.py ESP_InfoDisplay/icons.h ESP_InfoDisplay/icons_rle.h
 
 
 #define WiFi_Logo_width 120
@@ -368,6 +370,9 @@ const char W2_Logo_bits[] PROGMEM = {
 ,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x80,0x00,0x00,0x00,0x00
   };
 
+// Weather icons
+#define wIco_width 80
+#define wIco_height 80
 const char wIco_clear_day_bits[] PROGMEM = {
 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
 ,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
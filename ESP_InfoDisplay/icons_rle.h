@@ -0,0 +1,372 @@
+/**
+  Run length encoded icons in program memory
+  Name: icons_rle.h
+  Purpose: WiFi, Clock and Weather logo. Icons for different weather conditions.
+
+  Generated from icons.h by tools/xbm2rle.py, do not edit.
+*/
+
+#pragma once
+
+#define WiFi_Logo_width 120
+#define WiFi_Logo_height 86
+// 501 bytes, 1290 as bitmap
+const uint8_t WiFi_Logo_rle[] PROGMEM = {
+0x35,0x8b,0x66,0x95,0x5e,0x9b,0x58,0xa1,0x53,0xa5,0x4f,0xa9,0x4b,0xad,0x48,0xaf,
+0x46,0xb2,0x42,0xb5,0x40,0xb7,0x3e,0xb9,0x3c,0xbb,0x2e,0xd5,0x1d,0xdd,0x17,0xe1,
+0x14,0xe3,0x11,0xe7,0x0e,0xe9,0x0c,0xeb,0x0a,0xed,0x08,0xc8,0x14,0x91,0x07,0xc3,
+0x1e,0x8c,0x06,0xc2,0x22,0x8b,0x04,0xc2,0x25,0x8a,0x03,0xc1,0x27,0x89,0x03,0xc0,
+0x29,0x89,0x01,0xc0,0x2a,0x89,0x01,0xae,0x00,0x90,0x21,0x81,0x07,0x88,0x01,0xac,
+0x05,0x8c,0x20,0x85,0x05,0x88,0x00,0x8c,0x06,0x83,0x06,0x83,0x06,0x82,0x06,0x8c,
+0x07,0x94,0x03,0x86,0x05,0x95,0x06,0x83,0x06,0x83,0x06,0x82,0x07,0x8b,0x07,0x94,
+0x02,0x87,0x05,0x96,0x05,0x83,0x06,0x83,0x06,0x82,0x07,0x8a,0x08,0x94,0x02,0x87,
+0x05,0x96,0x05,0x83,0x07,0x82,0x06,0x83,0x05,0x8b,0x08,0x94,0x03,0x86,0x05,0x96,
+0x05,0x83,0x07,0x82,0x05,0x85,0x03,0x8c,0x08,0x94,0x04,0x84,0x06,0x96,0x06,0x81,
+0x08,0x82,0x05,0x96,0x08,0x94,0x11,0x95,0x06,0x81,0x08,0x82,0x05,0x96,0x08,0x86,
+0x1f,0x96,0x05,0x81,0x08,0x82,0x05,0x84,0x05,0x8b,0x08,0x86,0x11,0x85,0x07,0x96,
+0x05,0x81,0x08,0x81,0x06,0x83,0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x96,0x05,0x81,
+0x08,0x81,0x05,0x84,0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x96,0x05,0x81,0x09,0x80,
+0x05,0x84,0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x97,0x04,0x81,0x09,0x80,0x05,0x84,
+0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x97,0x04,0x80,0x04,0x80,0x04,0x80,0x05,0x84,
+0x06,0x8b,0x08,0x92,0x05,0x85,0x07,0x97,0x0a,0x81,0x03,0x80,0x05,0x84,0x06,0x8b,
+0x08,0x93,0x04,0x85,0x07,0x97,0x0a,0x81,0x09,0x85,0x06,0x8b,0x08,0x93,0x04,0x85,
+0x07,0x97,0x0a,0x81,0x09,0x85,0x06,0x8b,0x08,0x93,0x04,0x85,0x07,0x98,0x09,0x81,
+0x09,0x85,0x06,0x8b,0x08,0x93,0x04,0x85,0x07,0x98,0x09,0x81,0x09,0x85,0x06,0x8b,
+0x08,0x93,0x04,0x85,0x07,0x98,0x09,0x81,0x09,0x85,0x06,0x8b,0x08,0x86,0x11,0x85,
+0x07,0x98,0x08,0x82,0x08,0x86,0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x99,0x07,0x83,
+0x07,0x86,0x06,0x8b,0x08,0x86,0x11,0x85,0x07,0x99,0x07,0x83,0x07,0x86,0x06,0x8b,
+0x08,0x86,0x11,0x85,0x07,0x99,0x07,0x83,0x07,0x86,0x06,0x8b,0x08,0x86,0x11,0x85,
+0x06,0x9a,0x07,0x83,0x06,0x87,0x06,0x8b,0x08,0x86,0x11,0x85,0x06,0x9b,0x06,0x83,
+0x06,0x87,0x06,0x8b,0x08,0x86,0x11,0x85,0x06,0x9b,0x05,0x84,0x06,0x87,0x06,0x8b,
+0x08,0x86,0x11,0x85,0x06,0x88,0x00,0xbd,0x2e,0x88,0x01,0xbd,0x2e,0x88,0x01,0xbc,
+0x2e,0x89,0x02,0xbb,0x2e,0x89,0x02,0xba,0x2e,0x89,0x03,0xb9,0x2e,0x8a,0x04,0xb7,
+0x2d,0x8b,0x06,0xb3,0x2f,0x8b,0x07,0xb3,0x29,0x91,0x08,0xed,0x0a,0xeb,0x0c,0xe9,
+0x0e,0xe7,0x11,0xe3,0x14,0xe1,0x17,0xdd,0x1c,0xd7,0x2d,0xbb,0x3c,0xb9,0x3e,0xb7,
+0x40,0xb5,0x42,0xb3,0x45,0xaf,0x48,0xad,0x4b,0xa9,0x4f,0xa5,0x53,0xa1,0x57,0x9d,
+0x5d,0x95,0x65,0x8d,0x34
+};
+
+#define Clk_Logo_width 80
+#define Clk_Logo_height 80
+// 361 bytes, 800 as bitmap
+const uint8_t Clk_Logo_rle[] PROGMEM = {
+0x22,0x89,0x40,0x93,0x38,0x9a,0x31,0x9f,0x2d,0xa3,0x29,0xa7,0x25,0xab,0x22,0x8e,
+0x0f,0x8e,0x20,0x8c,0x15,0x8d,0x1c,0x8b,0x1b,0x8b,0x1a,0x8a,0x1f,0x8a,0x18,0x8a,
+0x22,0x89,0x16,0x89,0x25,0x89,0x14,0x89,0x27,0x89,0x12,0x88,0x13,0x82,0x14,0x88,
+0x11,0x87,0x14,0x83,0x14,0x88,0x0f,0x87,0x15,0x83,0x15,0x87,0x0e,0x87,0x16,0x83,
+0x16,0x87,0x0c,0x87,0x17,0x83,0x17,0x87,0x0b,0x87,0x17,0x83,0x17,0x87,0x0a,0x87,
+0x18,0x83,0x18,0x87,0x09,0x86,0x19,0x83,0x19,0x86,0x08,0x87,0x19,0x83,0x1a,0x86,
+0x07,0x86,0x1a,0x83,0x1a,0x86,0x06,0x86,0x1b,0x83,0x1b,0x86,0x05,0x86,0x1b,0x83,
+0x1b,0x86,0x05,0x85,0x1c,0x83,0x1c,0x86,0x03,0x86,0x1c,0x83,0x1c,0x86,0x03,0x86,
+0x1c,0x83,0x1d,0x85,0x03,0x85,0x1d,0x83,0x0e,0x82,0x0b,0x86,0x01,0x86,0x1d,0x83,
+0x0d,0x84,0x0a,0x86,0x01,0x86,0x1d,0x83,0x0c,0x85,0x0a,0x86,0x01,0x85,0x1e,0x83,
+0x0a,0x86,0x0c,0x85,0x01,0x85,0x1e,0x83,0x09,0x86,0x0d,0x85,0x01,0x85,0x1e,0x83,
+0x07,0x87,0x0e,0x8d,0x1e,0x83,0x06,0x86,0x10,0x8d,0x1e,0x83,0x04,0x87,0x11,0x8d,
+0x1e,0x83,0x03,0x86,0x14,0x8c,0x1e,0x83,0x01,0x87,0x15,0x8c,0x1e,0x83,0x00,0x86,
+0x17,0x8c,0x1e,0x8a,0x18,0x8c,0x1e,0x89,0x19,0x8c,0x1e,0x87,0x1b,0x8c,0x1e,0x86,
+0x1b,0x8d,0x1e,0x84,0x1d,0x86,0x00,0x85,0x1e,0x83,0x1e,0x86,0x00,0x85,0x41,0x86,
+0x00,0x85,0x41,0x85,0x01,0x86,0x40,0x85,0x01,0x86,0x3f,0x86,0x02,0x85,0x3f,0x86,
+0x02,0x86,0x3e,0x85,0x03,0x86,0x3d,0x86,0x03,0x86,0x3d,0x86,0x04,0x86,0x3b,0x86,
+0x05,0x86,0x3b,0x86,0x06,0x86,0x39,0x87,0x06,0x86,0x39,0x86,0x08,0x86,0x37,0x87,
+0x08,0x87,0x35,0x87,0x0a,0x87,0x34,0x86,0x0b,0x87,0x33,0x87,0x0c,0x87,0x31,0x87,
+0x0e,0x87,0x2f,0x87,0x0f,0x88,0x2d,0x88,0x10,0x88,0x2b,0x88,0x12,0x88,0x29,0x88,
+0x14,0x89,0x25,0x89,0x16,0x89,0x23,0x89,0x18,0x8a,0x1f,0x8a,0x1a,0x8b,0x1b,0x8b,
+0x1c,0x8c,0x17,0x8c,0x1f,0x8e,0x10,0x8d,0x22,0x92,0x05,0x92,0x25,0xa7,0x29,0xa4,
+0x2c,0xa0,0x30,0x9b,0x36,0x95,0x3e,0x8c,0x20
+};
+
+#define W1_Logo_width 104
+#define W1_Logo_height 86
+// 327 bytes, 1118 as bitmap
+const uint8_t W1_Logo_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x31,0x89,0x5a,0x8f,0x55,0x94,0x50,0x97,
+0x4e,0x9a,0x4a,0x9d,0x48,0x9f,0x47,0xa0,0x45,0x8b,0x09,0x8c,0x43,0x8a,0x0e,0x8a,
+0x41,0x89,0x11,0x89,0x41,0x88,0x13,0x89,0x3f,0x88,0x15,0x88,0x3e,0x88,0x17,0x88,
+0x3d,0x88,0x17,0x88,0x3c,0x88,0x19,0x87,0x3c,0x87,0x1a,0x88,0x35,0x8d,0x1b,0x8b,
+0x2f,0x8f,0x1b,0x8e,0x2a,0x91,0x1b,0x90,0x27,0x93,0x1a,0x91,0x25,0x95,0x1a,0x92,
+0x22,0x97,0x19,0x92,0x21,0x99,0x18,0x93,0x1f,0x9a,0x18,0x86,0x01,0x8b,0x1e,0x89,
+0x07,0x89,0x17,0x86,0x04,0x88,0x1d,0x88,0x0a,0x88,0x17,0x86,0x05,0x88,0x1c,0x87,
+0x0c,0x87,0x16,0x87,0x06,0x87,0x1b,0x88,0x0d,0x85,0x17,0x87,0x07,0x87,0x1a,0x87,
+0x10,0x81,0x1a,0x85,0x08,0x87,0x1a,0x87,0x2e,0x83,0x0a,0x86,0x1a,0x87,0x3d,0x86,
+0x1a,0x86,0x3e,0x86,0x1a,0x86,0x3e,0x86,0x1a,0x86,0x3e,0x86,0x1a,0x87,0x3d,0x86,
+0x1b,0x86,0x3c,0x87,0x1b,0x87,0x3b,0x87,0x1b,0x88,0x39,0x87,0x1d,0x88,0x37,0x88,
+0x1d,0x8a,0x33,0x8a,0x1e,0x8e,0x15,0x80,0x14,0x8c,0x20,0x96,0x05,0x80,0x04,0x83,
+0x07,0x97,0x21,0x95,0x04,0x82,0x03,0x83,0x06,0x97,0x22,0x96,0x02,0x84,0x02,0x83,
+0x06,0x96,0x25,0x94,0x03,0x84,0x00,0x83,0x07,0x95,0x27,0x92,0x04,0x89,0x07,0x93,
+0x2b,0x90,0x05,0x87,0x03,0x81,0x03,0x90,0x31,0x8b,0x07,0x8d,0x03,0x8b,0x48,0x8e,
+0x54,0x92,0x54,0x8e,0x58,0x8d,0x52,0x81,0x05,0x81,0x02,0x88,0x4b,0x80,0x04,0x83,
+0x08,0x88,0x4a,0x82,0x02,0x83,0x09,0x83,0x00,0x84,0x48,0x84,0x01,0x83,0x08,0x83,
+0x02,0x84,0x47,0x8a,0x08,0x83,0x03,0x81,0x4a,0x88,0x09,0x83,0x51,0x87,0x01,0x83,
+0x05,0x80,0x53,0x8c,0x58,0x8e,0x54,0x92,0x55,0x8c,0x5a,0x8c,0x5a,0x82,0x02,0x87,
+0x5e,0x89,0x5d,0x83,0x01,0x84,0x5c,0x83,0x02,0x83,0x5b,0x83,0x03,0x82,0x5c,0x83,
+0x04,0x80,0x7f,0x7f,0x7f,0x7f,0x55
+};
+
+#define W2_Logo_width 104
+#define W2_Logo_height 86
+// 182 bytes, 1118 as bitmap
+const uint8_t W2_Logo_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x6e,0x80,0x65,0x83,0x63,0x85,0x60,0x87,0x5f,0x88,0x5d,0x88,0x5d,
+0x88,0x5e,0x88,0x5d,0x88,0x5e,0x88,0x5d,0x88,0x5e,0x88,0x5d,0x88,0x5e,0x87,0x60,
+0x86,0x62,0x83,0x0e,0x82,0x53,0x81,0x0c,0x85,0x60,0x86,0x5e,0x89,0x5b,0x8b,0x59,
+0x8e,0x57,0x8e,0x57,0x8e,0x59,0x8b,0x5b,0x89,0x5e,0x86,0x60,0x85,0x62,0x82,0x65,
+0x80,0x7f,0x7f,0x7f,0x7f,0x7f,0x58,0x8e,0x58,0x8e,0x58,0x8e,0x58,0x8e,0x58,0x8e,
+0x58,0x8e,0x58,0x8e,0x58,0x8e,0x7f,0x7f,0x7f,0x7f,0x7f,0x46,0x80,0x65,0x83,0x63,
+0x84,0x61,0x87,0x5e,0x8a,0x5c,0x8c,0x59,0x8e,0x59,0x8f,0x59,0x8d,0x5b,0x8a,0x5e,
+0x88,0x5f,0x86,0x52,0x81,0x0d,0x84,0x50,0x83,0x0f,0x81,0x4f,0x86,0x5f,0x88,0x5e,
+0x88,0x5f,0x88,0x4f,0x86,0x08,0x88,0x4e,0x86,0x08,0x88,0x4e,0x86,0x09,0x88,0x4d,
+0x86,0x09,0x88,0x4d,0x86,0x0a,0x88,0x4c,0x86,0x0a,0x88,0x4c,0x86,0x0b,0x88,0x4b,
+0x86,0x0c,0x86,0x4c,0x86,0x0c,0x85,0x4d,0x86,0x0d,0x82,0x4f,0x86,0x60,0x86,0x60,
+0x86,0x60,0x86,0x60,0x86,0x26
+};
+
+#define wIco_width 80
+#define wIco_height 80
+// 251 bytes, 800 as bitmap
+const uint8_t wIco_clear_day_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x25,0x83,0x4b,0x83,0x4b,0x83,0x4b,0x83,0x4b,0x83,0x4b,
+0x83,0x4b,0x83,0x4b,0x84,0x36,0x81,0x11,0x83,0x11,0x81,0x22,0x83,0x25,0x83,0x20,
+0x85,0x23,0x85,0x1f,0x86,0x21,0x86,0x20,0x86,0x1f,0x86,0x22,0x86,0x1d,0x86,0x24,
+0x85,0x1d,0x85,0x26,0x84,0x08,0x8b,0x08,0x84,0x28,0x82,0x07,0x8f,0x07,0x82,0x32,
+0x93,0x3a,0x95,0x38,0x97,0x36,0x87,0x09,0x87,0x34,0x86,0x0d,0x86,0x32,0x86,0x0f,
+0x86,0x31,0x85,0x11,0x85,0x30,0x85,0x13,0x85,0x2f,0x84,0x15,0x84,0x2e,0x85,0x15,
+0x85,0x2d,0x84,0x17,0x84,0x2d,0x84,0x17,0x84,0x2d,0x84,0x17,0x84,0x1e,0x88,0x05,
+0x84,0x17,0x84,0x05,0x88,0x0f,0x88,0x04,0x85,0x17,0x84,0x05,0x88,0x0f,0x89,0x04,
+0x84,0x17,0x84,0x05,0x89,0x0e,0x88,0x05,0x84,0x17,0x84,0x05,0x88,0x1e,0x84,0x17,
+0x84,0x2d,0x84,0x17,0x84,0x2d,0x84,0x17,0x84,0x2d,0x85,0x15,0x85,0x2e,0x84,0x15,
+0x84,0x2f,0x85,0x13,0x85,0x30,0x85,0x11,0x85,0x31,0x86,0x0f,0x86,0x32,0x86,0x0d,
+0x86,0x34,0x87,0x09,0x87,0x36,0x97,0x38,0x95,0x3a,0x93,0x32,0x82,0x07,0x8f,0x07,
+0x82,0x28,0x84,0x08,0x8b,0x08,0x84,0x26,0x85,0x1d,0x85,0x24,0x86,0x1d,0x86,0x22,
+0x86,0x1f,0x86,0x20,0x86,0x21,0x86,0x1f,0x85,0x23,0x85,0x20,0x83,0x25,0x83,0x22,
+0x81,0x11,0x83,0x11,0x81,0x37,0x83,0x4b,0x83,0x4b,0x83,0x4b,0x83,0x4b,0x83,0x4b,
+0x83,0x4b,0x84,0x4a,0x83,0x7f,0x7f,0x7f,0x7f,0x7f,0x25
+};
+
+// 155 bytes, 800 as bitmap
+const uint8_t wIco_clear_night_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x2f,0x84,0x48,
+0x86,0x46,0x88,0x45,0x89,0x44,0x8a,0x43,0x8a,0x43,0x8b,0x43,0x8b,0x42,0x86,0x00,
+0x84,0x42,0x85,0x01,0x84,0x41,0x85,0x02,0x84,0x41,0x84,0x03,0x85,0x3f,0x85,0x04,
+0x84,0x3f,0x84,0x05,0x84,0x3f,0x84,0x05,0x85,0x3e,0x84,0x06,0x84,0x3e,0x84,0x06,
+0x85,0x3d,0x84,0x06,0x86,0x3c,0x84,0x07,0x86,0x3b,0x84,0x08,0x86,0x3a,0x84,0x08,
+0x87,0x39,0x84,0x09,0x88,0x37,0x84,0x0a,0x8a,0x05,0x84,0x29,0x84,0x0b,0x94,0x29,
+0x85,0x0c,0x92,0x2a,0x84,0x0d,0x91,0x2a,0x85,0x0f,0x8e,0x2b,0x85,0x11,0x8a,0x2c,
+0x86,0x14,0x86,0x2d,0x86,0x12,0x86,0x2e,0x87,0x10,0x87,0x2f,0x87,0x0e,0x87,0x31,
+0x89,0x09,0x88,0x33,0x9a,0x35,0x98,0x38,0x94,0x3c,0x90,0x40,0x8c,0x7f,0x7f,0x7f,
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x30
+};
+
+// 268 bytes, 800 as bitmap
+const uint8_t wIco_rain_rle[] PROGMEM = {
+0x22,0x89,0x41,0x91,0x3b,0x95,0x37,0x99,0x34,0x9b,0x31,0x8b,0x07,0x8b,0x2e,0x89,
+0x0d,0x89,0x2c,0x88,0x11,0x88,0x2a,0x87,0x15,0x87,0x28,0x87,0x17,0x87,0x20,0x8d,
+0x19,0x8d,0x16,0x8f,0x1b,0x8f,0x11,0x90,0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,
+0x21,0x90,0x0a,0x88,0x06,0x81,0x21,0x81,0x06,0x88,0x08,0x87,0x37,0x87,0x06,0x86,
+0x3b,0x86,0x04,0x86,0x3d,0x86,0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,
+0x41,0x85,0x01,0x84,0x43,0x84,0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,
+0x41,0x85,0x01,0x85,0x41,0x85,0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,
+0x3b,0x86,0x06,0x87,0x0a,0x82,0x1b,0x82,0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,
+0x06,0x88,0x0a,0x95,0x17,0x95,0x0c,0x95,0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,
+0x0d,0x96,0x16,0x88,0x01,0x8b,0x07,0x8b,0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,
+0x3b,0x91,0x41,0x89,0x7f,0x05,0x81,0x4c,0x83,0x4b,0x83,0x4a,0x85,0x49,0x85,0x48,
+0x87,0x47,0x87,0x46,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x21,0x81,0x22,0x87,0x21,
+0x83,0x21,0x87,0x21,0x83,0x23,0x83,0x22,0x85,0x38,0x80,0x0f,0x85,0x37,0x81,0x0e,
+0x87,0x35,0x83,0x0d,0x87,0x35,0x83,0x0c,0x89,0x33,0x85,0x0b,0x89,0x33,0x86,0x0a,
+0x89,0x32,0x87,0x0a,0x89,0x32,0x88,0x0a,0x87,0x32,0x89,0x0a,0x87,0x32,0x89,0x0c,
+0x83,0x34,0x89,0x45,0x89,0x46,0x88,0x46,0x87,0x49,0x84,0x24
+};
+
+// 351 bytes, 800 as bitmap
+const uint8_t wIco_snow_rle[] PROGMEM = {
+0x22,0x89,0x41,0x91,0x3b,0x95,0x37,0x99,0x34,0x9b,0x31,0x8b,0x07,0x8b,0x2e,0x89,
+0x0d,0x89,0x2c,0x88,0x11,0x88,0x2a,0x87,0x15,0x87,0x28,0x87,0x17,0x87,0x20,0x8d,
+0x19,0x8d,0x16,0x8f,0x1b,0x8f,0x11,0x90,0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,
+0x21,0x90,0x0a,0x88,0x06,0x81,0x21,0x81,0x06,0x88,0x08,0x87,0x37,0x87,0x06,0x86,
+0x3b,0x86,0x04,0x86,0x3d,0x86,0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,
+0x41,0x85,0x01,0x84,0x43,0x84,0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,
+0x41,0x85,0x01,0x85,0x41,0x85,0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,
+0x3b,0x86,0x06,0x87,0x0a,0x82,0x1b,0x82,0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,
+0x06,0x88,0x0a,0x95,0x17,0x95,0x0c,0x95,0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,
+0x0d,0x96,0x16,0x88,0x01,0x8b,0x07,0x8b,0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,
+0x3b,0x91,0x2b,0x82,0x12,0x89,0x2f,0x82,0x45,0x83,0x01,0x83,0x45,0x89,0x16,0x81,
+0x2d,0x89,0x00,0x81,0x11,0x83,0x2d,0x8c,0x0f,0x85,0x14,0x82,0x14,0x83,0x00,0x87,
+0x0f,0x85,0x14,0x82,0x13,0x83,0x02,0x85,0x10,0x85,0x14,0x83,0x01,0x83,0x0a,0x85,
+0x02,0x83,0x12,0x85,0x14,0x89,0x0a,0x8b,0x0b,0x82,0x04,0x85,0x04,0x82,0x08,0x81,
+0x00,0x89,0x0b,0x8c,0x09,0x85,0x00,0x89,0x00,0x85,0x06,0x8c,0x10,0x89,0x08,0x97,
+0x06,0x87,0x00,0x83,0x11,0x83,0x00,0x83,0x08,0x97,0x07,0x85,0x02,0x83,0x0f,0x83,
+0x02,0x82,0x08,0x97,0x09,0x83,0x02,0x85,0x0d,0x83,0x10,0x93,0x0c,0x8b,0x0e,0x81,
+0x12,0x86,0x03,0x86,0x0c,0x8c,0x24,0x84,0x05,0x84,0x0c,0x89,0x28,0x84,0x05,0x84,
+0x0c,0x83,0x00,0x83,0x29,0x85,0x03,0x85,0x0c,0x82,0x02,0x83,0x26,0x88,0x01,0x88,
+0x10,0x83,0x25,0x95,0x10,0x81,0x25,0x97,0x37,0x97,0x37,0x97,0x37,0x84,0x02,0x87,
+0x02,0x84,0x40,0x85,0x49,0x85,0x49,0x85,0x49,0x85,0x49,0x85,0x4a,0x83,0x25
+};
+
+// 307 bytes, 800 as bitmap
+const uint8_t wIco_sleet_rle[] PROGMEM = {
+0x22,0x89,0x41,0x91,0x3b,0x95,0x37,0x99,0x34,0x9b,0x31,0x8b,0x07,0x8b,0x2e,0x89,
+0x0d,0x89,0x2c,0x88,0x11,0x88,0x2a,0x87,0x15,0x87,0x28,0x87,0x17,0x87,0x20,0x8d,
+0x19,0x8d,0x16,0x8f,0x1b,0x8f,0x11,0x90,0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,
+0x21,0x90,0x0a,0x88,0x06,0x81,0x21,0x81,0x06,0x88,0x08,0x87,0x37,0x87,0x06,0x86,
+0x3b,0x86,0x04,0x86,0x3d,0x86,0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,
+0x41,0x85,0x01,0x84,0x43,0x84,0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,
+0x41,0x85,0x01,0x85,0x41,0x85,0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,
+0x3b,0x86,0x06,0x87,0x0a,0x82,0x1b,0x82,0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,
+0x06,0x88,0x0a,0x95,0x17,0x95,0x0c,0x95,0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,
+0x0d,0x96,0x16,0x88,0x01,0x8b,0x07,0x8b,0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,
+0x3b,0x91,0x33,0x82,0x0a,0x89,0x36,0x83,0x45,0x83,0x01,0x83,0x45,0x88,0x47,0x88,
+0x01,0x80,0x44,0x8b,0x43,0x83,0x00,0x86,0x1d,0x80,0x23,0x83,0x02,0x85,0x1c,0x82,
+0x20,0x85,0x02,0x83,0x1e,0x82,0x03,0x81,0x1a,0x8b,0x1f,0x83,0x00,0x83,0x1a,0x8c,
+0x1e,0x88,0x1e,0x89,0x19,0x8c,0x1e,0x84,0x00,0x83,0x18,0x8c,0x1f,0x83,0x02,0x81,
+0x0d,0x80,0x0a,0x86,0x01,0x83,0x1f,0x82,0x12,0x81,0x0c,0x84,0x02,0x84,0x1e,0x81,
+0x11,0x83,0x0c,0x83,0x01,0x86,0x31,0x84,0x0b,0x8c,0x30,0x85,0x0a,0x89,0x00,0x81,
+0x31,0x86,0x09,0x88,0x34,0x87,0x09,0x83,0x01,0x82,0x34,0x88,0x09,0x80,0x03,0x82,
+0x33,0x89,0x0e,0x82,0x33,0x89,0x45,0x89,0x45,0x89,0x46,0x87,0x48,0x86,0x49,0x83,
+0x7f,0x7f,0x15
+};
+
+// 195 bytes, 800 as bitmap
+const uint8_t wIco_wind_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x6d,0x89,0x42,0x8f,
+0x3d,0x93,0x39,0x96,0x37,0x99,0x34,0x89,0x07,0x89,0x2f,0x8a,0x0c,0x8b,0x28,0x8c,
+0x0f,0x8b,0x25,0x8b,0x12,0x8c,0x21,0x8c,0x14,0x8d,0x1e,0x8c,0x16,0x8d,0x1c,0x88,
+0x21,0x88,0x1a,0x87,0x25,0x86,0x1a,0x86,0x27,0x86,0x18,0x86,0x29,0x85,0x07,0x8c,
+0x03,0x85,0x2b,0x85,0x05,0x8e,0x01,0x85,0x2d,0x84,0x05,0x8e,0x01,0x85,0x2d,0x85,
+0x04,0x8e,0x01,0x84,0x2e,0x85,0x05,0x8c,0x02,0x84,0x2f,0x84,0x15,0x84,0x2f,0x84,
+0x15,0x84,0x2f,0x84,0x15,0x84,0x2f,0x84,0x15,0x84,0x2f,0x84,0x15,0x84,0x2e,0x85,
+0x00,0x8c,0x07,0x85,0x2d,0x94,0x06,0x85,0x2d,0x84,0x00,0x8e,0x07,0x85,0x2b,0x85,
+0x00,0x8e,0x07,0x86,0x29,0x85,0x02,0x8c,0x09,0x86,0x27,0x86,0x19,0x87,0x25,0x86,
+0x1b,0x88,0x05,0x80,0x1a,0x88,0x1c,0x90,0x0f,0x90,0x1e,0x90,0x0c,0x91,0x21,0x91,
+0x07,0x91,0x07,0x96,0x05,0xa9,0x07,0x98,0x07,0xa3,0x0a,0x98,0x0f,0x93,0x12,0x98,
+0x11,0x8f,0x15,0x96,0x15,0x89,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,
+0x7f,0x7f,0x57
+};
+
+// 145 bytes, 800 as bitmap
+const uint8_t wIco_fog_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x42,0x89,0x41,0x91,0x3b,0x95,0x37,0x99,0x34,0x9b,
+0x31,0x8b,0x07,0x8b,0x2e,0x89,0x0d,0x89,0x2c,0x88,0x11,0x88,0x2a,0x87,0x15,0x87,
+0x28,0x87,0x17,0x87,0x20,0x8d,0x19,0x8d,0x16,0x8f,0x1b,0x8f,0x11,0x90,0x1d,0x90,
+0x0e,0x90,0x1f,0x90,0x0c,0x90,0x21,0x90,0x0a,0x88,0x06,0x81,0x21,0x81,0x06,0x88,
+0x08,0x87,0x37,0x87,0x06,0x86,0x3b,0x86,0x04,0x86,0x3d,0x86,0x03,0x85,0x3f,0x85,
+0x02,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x01,0x84,0x43,0x84,0x00,0x85,0x43,0x8a,
+0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x84,0x7f,0x7f,0x7f,0x10,
+0xcd,0x00,0xff,0xef,0x00,0xcd,0x7f,0x7f,0x7f,0x11,0xcd,0x00,0xff,0xef,0x00,0xcd,
+0x7f,0x7f,0x7f,0x11,0xcd,0x00,0xff,0xef,0x00,0xcd,0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,
+0x20
+};
+
+// 275 bytes, 800 as bitmap
+const uint8_t wIco_cloudy_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x7f,0x7f,0x4d,0x87,0x44,0x8d,0x3f,0x91,0x3b,0x95,0x38,0x97,
+0x36,0x89,0x05,0x89,0x34,0x87,0x0b,0x87,0x2e,0x8a,0x0f,0x8a,0x26,0x8c,0x11,0x8c,
+0x21,0x8d,0x13,0x8d,0x1e,0x8d,0x15,0x8d,0x1c,0x8d,0x17,0x8d,0x1a,0x88,0x02,0x82,
+0x17,0x82,0x02,0x88,0x18,0x87,0x27,0x87,0x17,0x85,0x05,0x8b,0x19,0x85,0x16,0x85,
+0x03,0x91,0x17,0x85,0x15,0x85,0x00,0x97,0x15,0x84,0x14,0x85,0x00,0x99,0x14,0x85,
+0x13,0xa2,0x12,0x85,0x13,0x8e,0x09,0x8a,0x12,0x84,0x13,0x8b,0x0f,0x88,0x11,0x84,
+0x13,0x89,0x13,0x87,0x10,0x84,0x13,0x88,0x15,0x87,0x0f,0x84,0x13,0x86,0x19,0x86,
+0x0e,0x84,0x0b,0x8d,0x1b,0x8d,0x05,0x85,0x09,0x8e,0x1d,0x8e,0x03,0x84,0x08,0x8f,
+0x1f,0x8f,0x00,0x85,0x07,0x90,0x1f,0x96,0x05,0x91,0x21,0x94,0x05,0x88,0x07,0x80,
+0x23,0x80,0x06,0x8a,0x06,0x86,0x39,0x87,0x05,0x86,0x3b,0x86,0x04,0x86,0x3d,0x86,
+0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x01,0x84,0x43,0x84,
+0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,0x41,0x85,0x01,0x85,0x41,0x85,
+0x02,0x85,0x3f,0x85,0x04,0x85,0x3d,0x85,0x05,0x86,0x3a,0x87,0x06,0x87,0x0a,0x82,
+0x1b,0x82,0x0a,0x87,0x08,0x89,0x04,0x86,0x19,0x86,0x04,0x89,0x0a,0x95,0x17,0x95,
+0x0c,0x95,0x15,0x95,0x0f,0x95,0x11,0x95,0x13,0x95,0x0d,0x95,0x18,0x86,0x03,0x8b,
+0x05,0x8b,0x03,0x86,0x27,0x9b,0x35,0x97,0x38,0x95,0x3c,0x8f,0x43,0x87,0x7f,0x7f,
+0x7f,0x7f,0x03
+};
+
+// 319 bytes, 800 as bitmap
+const uint8_t wIco_partly_cloudy_day_rle[] PROGMEM = {
+0x1e,0x82,0x4b,0x84,0x4a,0x84,0x4a,0x84,0x4a,0x84,0x4a,0x84,0x4a,0x84,0x4a,0x84,
+0x4a,0x84,0x35,0x83,0x11,0x82,0x11,0x83,0x20,0x84,0x24,0x84,0x20,0x85,0x22,0x85,
+0x20,0x86,0x20,0x86,0x21,0x86,0x1e,0x86,0x23,0x85,0x1e,0x85,0x25,0x84,0x0a,0x88,
+0x0a,0x84,0x27,0x83,0x07,0x8e,0x07,0x83,0x32,0x92,0x3b,0x94,0x39,0x96,0x37,0x88,
+0x06,0x88,0x35,0x87,0x0a,0x87,0x33,0x86,0x0e,0x86,0x31,0x86,0x10,0x86,0x30,0x85,
+0x12,0x85,0x2f,0x85,0x14,0x85,0x2e,0x85,0x14,0x85,0x2e,0x84,0x16,0x84,0x2d,0x85,
+0x16,0x85,0x2c,0x84,0x18,0x84,0x1e,0x87,0x05,0x84,0x0e,0x8e,0x05,0x87,0x0f,0x89,
+0x04,0x84,0x0a,0x92,0x04,0x89,0x0e,0x89,0x04,0x84,0x08,0x95,0x03,0x89,0x0e,0x89,
+0x04,0x84,0x06,0x99,0x01,0x89,0x0f,0x87,0x05,0x84,0x05,0x9b,0x01,0x87,0x1e,0x84,
+0x03,0x8b,0x07,0x8b,0x26,0x85,0x01,0x89,0x0d,0x89,0x26,0x84,0x00,0x88,0x11,0x88,
+0x25,0x8c,0x15,0x87,0x24,0x8b,0x17,0x87,0x20,0x8d,0x19,0x8d,0x16,0x8f,0x1b,0x8f,
+0x11,0x90,0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,0x21,0x90,0x0a,0x88,0x06,0x81,
+0x21,0x81,0x06,0x88,0x08,0x87,0x37,0x87,0x06,0x86,0x3b,0x86,0x04,0x86,0x3d,0x86,
+0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x01,0x84,0x43,0x84,
+0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,0x41,0x85,0x01,0x85,0x41,0x85,
+0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,0x3b,0x86,0x06,0x87,0x0a,0x82,
+0x1b,0x82,0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,0x06,0x88,0x0a,0x95,0x17,0x95,
+0x0c,0x95,0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,0x0d,0x96,0x16,0x88,0x01,0x8b,
+0x07,0x8b,0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,0x3b,0x91,0x41,0x89,0x22
+};
+
+// 285 bytes, 800 as bitmap
+const uint8_t wIco_partly_cloudy_night_rle[] PROGMEM = {
+0x7f,0x7f,0x7f,0x7f,0x0f,0x83,0x49,0x86,0x47,0x87,0x45,0x89,0x44,0x89,0x44,0x8a,
+0x43,0x8b,0x43,0x8b,0x42,0x86,0x00,0x84,0x41,0x86,0x01,0x84,0x41,0x85,0x02,0x84,
+0x40,0x85,0x03,0x84,0x40,0x85,0x03,0x84,0x40,0x84,0x04,0x85,0x3f,0x84,0x05,0x84,
+0x3e,0x85,0x05,0x85,0x3d,0x84,0x06,0x85,0x3d,0x84,0x07,0x85,0x3c,0x84,0x07,0x86,
+0x3b,0x84,0x08,0x86,0x3a,0x84,0x09,0x86,0x39,0x84,0x09,0x88,0x37,0x85,0x09,0x89,
+0x08,0x82,0x2a,0x84,0x0a,0x95,0x27,0x89,0x09,0x93,0x23,0x91,0x06,0x92,0x21,0x95,
+0x06,0x90,0x1f,0x99,0x06,0x8d,0x1f,0x9b,0x0c,0x86,0x1d,0x8b,0x07,0x8b,0x0a,0x85,
+0x1d,0x89,0x0d,0x89,0x07,0x86,0x1d,0x88,0x11,0x88,0x05,0x87,0x1c,0x87,0x15,0x87,
+0x02,0x88,0x1c,0x87,0x17,0x91,0x16,0x8d,0x19,0x8f,0x14,0x8f,0x1b,0x8f,0x11,0x90,
+0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,0x21,0x90,0x0a,0x88,0x06,0x81,0x21,0x81,
+0x06,0x88,0x08,0x87,0x37,0x87,0x06,0x86,0x3b,0x86,0x04,0x86,0x3d,0x86,0x03,0x85,
+0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x01,0x84,0x43,0x84,0x00,0x85,
+0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x8a,
+0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x02,0x85,
+0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,0x3b,0x86,0x06,0x87,0x0a,0x82,0x1b,0x82,
+0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,0x06,0x88,0x0a,0x95,0x17,0x95,0x0c,0x95,
+0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,0x0d,0x96,0x16,0x88,0x01,0x8b,0x07,0x8b,
+0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,0x3b,0x91,0x41,0x89,0x22
+};
+
+// 280 bytes, 800 as bitmap
+const uint8_t wIco_hail_rle[] PROGMEM = {
+0x22,0x89,0x41,0x91,0x3b,0x95,0x37,0x99,0x34,0x9b,0x31,0x8b,0x07,0x8b,0x2e,0x89,
+0x0d,0x89,0x2c,0x88,0x11,0x88,0x2a,0x87,0x15,0x87,0x28,0x87,0x17,0x87,0x20,0x8d,
+0x19,0x8d,0x16,0x8f,0x1b,0x8f,0x11,0x90,0x1d,0x90,0x0e,0x90,0x1f,0x90,0x0c,0x90,
+0x21,0x90,0x0a,0x88,0x33,0x88,0x08,0x87,0x37,0x87,0x06,0x86,0x3b,0x86,0x04,0x86,
+0x3d,0x86,0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x85,0x41,0x85,0x01,0x84,
+0x43,0x84,0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x89,0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x85,0x41,0x85,0x01,0x85,
+0x41,0x85,0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,0x3b,0x86,0x06,0x87,
+0x0a,0x81,0x1d,0x81,0x0a,0x87,0x08,0x88,0x06,0x85,0x19,0x85,0x06,0x88,0x0a,0x95,
+0x17,0x95,0x0c,0x95,0x15,0x95,0x0e,0x96,0x11,0x96,0x11,0x96,0x0d,0x96,0x16,0x88,
+0x01,0x8b,0x07,0x8b,0x01,0x88,0x26,0x9b,0x34,0x99,0x37,0x95,0x3b,0x91,0x41,0x89,
+0x2f,0x83,0x2d,0x83,0x17,0x87,0x29,0x87,0x15,0x87,0x29,0x87,0x14,0x89,0x27,0x89,
+0x13,0x89,0x27,0x89,0x13,0x89,0x11,0x83,0x11,0x89,0x13,0x89,0x0f,0x87,0x0f,0x89,
+0x14,0x87,0x10,0x87,0x10,0x87,0x15,0x87,0x0f,0x89,0x0f,0x87,0x17,0x83,0x11,0x89,
+0x11,0x83,0x2f,0x89,0x45,0x89,0x46,0x87,0x47,0x87,0x49,0x83,0x7f,0x7f,0x7f,0x4c,
+0x83,0x19,0x83,0x2b,0x87,0x15,0x87,0x29,0x87,0x15,0x87,0x28,0x89,0x13,0x89,0x27,
+0x89,0x13,0x89,0x27,0x89,0x13,0x89,0x27,0x89,0x13,0x89,0x28,0x87,0x15,0x87,0x29,
+0x87,0x15,0x87,0x2b,0x83,0x19,0x83,0x16
+};
+
+// 297 bytes, 800 as bitmap
+const uint8_t wIco_thunderstorm_rle[] PROGMEM = {
+0x2c,0x89,0x42,0x8f,0x3d,0x93,0x3a,0x95,0x37,0x99,0x34,0x8a,0x05,0x8a,0x32,0x88,
+0x0b,0x88,0x2d,0x8a,0x0f,0x8a,0x26,0x8c,0x11,0x8c,0x21,0x8d,0x13,0x8d,0x1e,0x8d,
+0x15,0x8d,0x1c,0x8d,0x17,0x8d,0x1a,0x88,0x03,0x81,0x17,0x81,0x03,0x88,0x18,0x86,
+0x29,0x86,0x17,0x85,0x04,0x8d,0x18,0x85,0x16,0x85,0x02,0x93,0x16,0x85,0x15,0x84,
+0x01,0x97,0x15,0x84,0x14,0xa1,0x13,0x85,0x13,0xa2,0x13,0x84,0x13,0x8d,0x0b,0x89,
+0x12,0x84,0x13,0x8b,0x0f,0x88,0x11,0x84,0x13,0x89,0x13,0x87,0x10,0x84,0x13,0x87,
+0x17,0x86,0x0f,0x84,0x13,0x86,0x19,0x86,0x0e,0x84,0x0b,0x8d,0x1b,0x8d,0x05,0x85,
+0x08,0x8f,0x1d,0x8f,0x02,0x84,0x08,0x8f,0x1f,0x8f,0x00,0x85,0x06,0x91,0x1f,0x96,
+0x05,0x91,0x21,0x94,0x05,0x88,0x35,0x89,0x05,0x87,0x39,0x87,0x05,0x86,0x3b,0x86,
+0x04,0x86,0x3d,0x86,0x03,0x85,0x3f,0x85,0x02,0x85,0x41,0x85,0x01,0x84,0x43,0x84,
+0x01,0x84,0x43,0x84,0x00,0x85,0x43,0x8a,0x45,0x89,0x45,0x89,0x45,0x89,0x45,0x89,
+0x45,0x89,0x45,0x8a,0x43,0x85,0x00,0x84,0x43,0x84,0x01,0x84,0x43,0x84,0x01,0x85,
+0x41,0x85,0x02,0x85,0x3f,0x85,0x03,0x86,0x3d,0x86,0x04,0x86,0x3b,0x86,0x05,0x87,
+0x0c,0x80,0x1d,0x80,0x0c,0x87,0x06,0x88,0x08,0x83,0x1b,0x83,0x08,0x88,0x08,0x8a,
+0x02,0x87,0x19,0x87,0x02,0x8a,0x0a,0x95,0x17,0x95,0x0c,0x96,0x13,0x96,0x0f,0x96,
+0x0f,0x96,0x13,0x96,0x0b,0x96,0x1a,0x82,0x05,0x8d,0x00,0x8e,0x05,0x82,0x29,0x9b,
+0x35,0x97,0x39,0x93,0x3e,0x8d,0x40,0x88,0x45,0x88,0x45,0x8a,0x45,0x8a,0x45,0x8a,
+0x45,0x8a,0x45,0x8a,0x45,0x88,0x45,0x88,0x46,0x86,0x47,0x86,0x48,0x84,0x49,0x84,
+0x4a,0x82,0x4b,0x82,0x4c,0x80,0x4d,0x80,0x30
+};
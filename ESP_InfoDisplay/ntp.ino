@@ -14,9 +14,13 @@
 #define NTP_LOCAL_PORT    8888
 #define NTP_TIME_ZONE     1
 #define NTP_PACKET_SIZE   48 // NTP time is in the first 48 bytes of message
+#define NTP_TIMEOUT       450  // Time to wait for the response (ms)
+#define NTP_POLL          10   // Check for the response every 10ms
 
 byte NTP_packetBuffer[NTP_PACKET_SIZE]; //buffer to hold incoming & outgoing packets
 WiFiUDP Udp;
+// when the last request was sent
+uint32_t NTP_requestTime;
 
 void NTP_startSync() 
 {
@@ -26,15 +30,19 @@ void NTP_startSync()
   Udp.begin(NTP_LOCAL_PORT);
   Serial.print("Local port: ");
   Serial.println(Udp.localPort());
-  Serial.println("waiting for sync");
-  setSyncProvider(NTP_getTime);
-  setSyncInterval(1);
 }
 
-time_t NTP_getTime()
+// Task: sends a request, NTP_receiveTask() waits for the response
+void NTP_requestTask()
 {
   IPAddress ntpServerIP; // NTP server's ip address
 
+  if (WiFi.status() != WL_CONNECTED)
+  {
+    tasks.runIn(taskNtp, TIMER_RETRY);
+    return;
+  }
+
   while (Udp.parsePacket() > 0) ; // discard any previously received packets
   Serial.println("Transmit NTP Request");
   // get a random server from the pool
@@ -43,31 +51,41 @@ time_t NTP_getTime()
   Serial.print(": ");
   Serial.println(ntpServerIP);
   NTP_sendPacket(ntpServerIP);
-  uint32_t beginWait = millis();
-  while (millis() - beginWait < 450) {
-    int size = Udp.parsePacket();
-    if (size >= NTP_PACKET_SIZE) {
-      Serial.println("Receive NTP Response");
-      Udp.read(NTP_packetBuffer, NTP_PACKET_SIZE);  // read packet into the buffer
-      unsigned long secsSince1900;
-      // convert four bytes starting at location 40 to a long integer
-      secsSince1900 =  (unsigned long)NTP_packetBuffer[40] << 24;
-      secsSince1900 |= (unsigned long)NTP_packetBuffer[41] << 16;
-      secsSince1900 |= (unsigned long)NTP_packetBuffer[42] << 8;
-      secsSince1900 |= (unsigned long)NTP_packetBuffer[43];
-      setSyncInterval(3600);
-      unsigned long epoch = secsSince1900 - 2208988800UL;   // convert to unix timestamp
-      epoch += 3600 * NTP_TIME_ZONE;                        // Add timezone
-      tmElements_t pretime;
-      breakTime(epoch,pretime);
-      int real_year=pretime.Year+1970;
-      // Check for DST
-      if (summertime_EU(real_year,pretime.Month,pretime.Day,pretime.Hour,1)) epoch+=3600;
-      return epoch;
-    }
+  NTP_requestTime = millis();
+  tasks.runIn(taskNtpReceive, NTP_POLL);
+}
+
+// Task: sets the time when the response has arrived
+void NTP_receiveTask()
+{
+  int size = Udp.parsePacket();
+  if (size >= NTP_PACKET_SIZE) {
+    Serial.println("Receive NTP Response");
+    Udp.read(NTP_packetBuffer, NTP_PACKET_SIZE);  // read packet into the buffer
+    unsigned long secsSince1900;
+    // convert four bytes starting at location 40 to a long integer
+    secsSince1900 =  (unsigned long)NTP_packetBuffer[40] << 24;
+    secsSince1900 |= (unsigned long)NTP_packetBuffer[41] << 16;
+    secsSince1900 |= (unsigned long)NTP_packetBuffer[42] << 8;
+    secsSince1900 |= (unsigned long)NTP_packetBuffer[43];
+    unsigned long epoch = secsSince1900 - 2208988800UL;   // convert to unix timestamp
+    epoch += 3600 * NTP_TIME_ZONE;                        // Add timezone
+    tmElements_t pretime;
+    breakTime(epoch,pretime);
+    int real_year=pretime.Year+1970;
+    // Check for DST
+    if (summertime_EU(real_year,pretime.Month,pretime.Day,pretime.Hour,1)) epoch+=3600;
+    setTime(epoch);
+    return;
+  }
+
+  if (millis() - NTP_requestTime < NTP_TIMEOUT)
+  {
+    tasks.runIn(taskNtpReceive, NTP_POLL);
+    return;
   }
   Serial.println("No NTP Response :-(");
-  return 0; // return 0 if unable to get the time
+  tasks.runIn(taskNtp, TIMER_RETRY);
 }
 
 // send an NTP request to the time server at the given address
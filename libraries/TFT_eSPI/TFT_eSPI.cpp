@@ -37,6 +37,34 @@
 // Fast SPI block write prototype
 void spiWriteBlock(uint16_t color, uint32_t repeat);
 
+// Optional count of the bytes sent to the TFT, enabled by TFT_SPI_STATS in User_Setup.h
+#ifdef TFT_SPI_STATS
+  static uint32_t spiByteCount = 0;
+  #define SPI_STAT(n) spiByteCount += (n)
+#else
+  #define SPI_STAT(n)
+#endif
+
+// Optional cache of FreeFont glyphs unpacked to RAM, enabled by GLYPH_CACHE in User_Setup.h.
+// It is shared by the TFT and all sprites, so text redrawn band by band is unpacked once.
+#if defined (LOAD_GFXFF) && defined (GLYPH_CACHE)
+  #ifndef GLYPH_CACHE_BYTES
+    #define GLYPH_CACHE_BYTES 96 // Largest cached bitmap, e.g. 24 x 32 pixels
+  #endif
+  typedef struct {
+    const GFXfont *font;              // NULL while the entry is unused
+    uint8_t  c, w, h;                 // Glyph index in the font and bitmap size
+    int8_t   xo, yo;                  // Offset from the cursor position
+    uint32_t used;                    // Last use, the least recently used entry is replaced
+    uint8_t  bits[GLYPH_CACHE_BYTES]; // Rows padded to whole bytes, MSB is the left pixel
+  } cachedGlyph;
+
+  static cachedGlyph glyphCache[GLYPH_CACHE];
+  static uint32_t    glyphUseCount = 0;
+
+  static cachedGlyph *getCachedGlyph(const GFXfont *font, uint8_t c);
+#endif
+
 // If the SPI library has transaction support, these functions
 // establish settings and protect from interference from other
 // libraries.  Otherwise, they simply do nothing.
@@ -336,6 +364,7 @@ void TFT_eSPI::spiwrite(uint8_t c)
 ***************************************************************************************/
 void TFT_eSPI::writecommand(uint8_t c)
 {
+  SPI_STAT(1);
   DC_C;
   CS_L;
   #ifdef SEND_16_BITS
@@ -353,6 +382,7 @@ void TFT_eSPI::writecommand(uint8_t c)
 ***************************************************************************************/
 void TFT_eSPI::writedata(uint8_t c)
 {
+  SPI_STAT(1);
   CS_L;
   #ifdef SEND_16_BITS
     SPI.transfer(0);
@@ -498,6 +528,7 @@ uint16_t TFT_eSPI::readPixel(int32_t x0, int32_t y0)
   setAddrWindow(x, y, x + w - 1, y + h - 1); // Sets CS low and sent RAMWR
 
   uint32_t len = w * h * 2;
+  SPI_STAT(len);
   // Push pixels into window rectangle, data is a 16 bit pointer thus increment is halved
   while ( len >=32 ) {SPI.writeBytes((uint8_t*)data, 32); data += 16; len -= 32; }
   if (len) SPI.writeBytes((uint8_t*)data, len);
@@ -537,6 +568,28 @@ uint16_t TFT_eSPI::readPixel(int32_t x0, int32_t y0)
 }
 
 
+/***************************************************************************************
+** Function name:           spiBytes
+** Description:             Bytes sent to the TFT since the last resetSpiBytes()
+***************************************************************************************/
+// Always 0 unless TFT_SPI_STATS is defined in User_Setup.h
+uint32_t TFT_eSPI::spiBytes(void)
+{
+#ifdef TFT_SPI_STATS
+  return spiByteCount;
+#else
+  return 0;
+#endif
+}
+
+void TFT_eSPI::resetSpiBytes(void)
+{
+#ifdef TFT_SPI_STATS
+  spiByteCount = 0;
+#endif
+}
+
+
 /***************************************************************************************
 ** Function name:           drawCircle
 ** Description:             Draw a circle outline
@@ -1053,6 +1106,9 @@ void TFT_eSPI::fillTriangle ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, in
 ** Function name:           drawBitmap
 ** Description:             Draw an image stored in an array on the TFT
 ***************************************************************************************/
+// 1 bit per pixel, MSB is the left pixel and rows are padded to whole bytes. Set
+// pixels are drawn as horizontal runs, the other pixels are left unchanged.
+
 void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
 
   spi_begin();
@@ -1061,9 +1117,112 @@ void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w
   int32_t i, j, byteWidth = (w + 7) / 8;
 
   for (j = 0; j < h; j++) {
-    for (i = 0; i < w; i++ ) {
-      if (pgm_read_byte(bitmap + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-        drawPixel(x + i, y + j, color);
+    if (y + j < 0) continue;
+    const uint8_t *row = bitmap + j * byteWidth;
+    uint8_t bits = 0;
+    int32_t run = 0;
+
+    for (i = 0; i <= w; i++) {
+      if ((i < w) && !(i & 7)) bits = pgm_read_byte(row + (i >> 3));
+      if ((i < w) && (bits & (128 >> (i & 7)))) run++;
+      else if (run) {
+        // drawFastHLine() does not clip on the left
+        int32_t xs = x + i - run;
+        if (xs < 0) { run += xs; xs = 0; }
+        if (run > 0) drawFastHLine(xs, y + j, run, color);
+        run = 0;
+      }
+    }
+  }
+
+  inTransaction = false;
+  spi_end();
+}
+
+
+/***************************************************************************************
+** Function name:           drawBitmap
+** Description:             Draw an image with a background colour in one window
+***************************************************************************************/
+// Each row is expanded to fgcolor and bgcolor pixels and streamed into a single
+// address window, a bitmap partly off the screen is drawn as fillRect() and runs
+
+void TFT_eSPI::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor) {
+
+  if ((x < 0) || (y < 0) || (x + w > (int32_t)_width) || (y + h > (int32_t)_height)) {
+    fillRect(x, y, w, h, bgcolor);
+    drawBitmap(x, y, bitmap, w, h, fgcolor);
+    return;
+  }
+
+  spi_begin();
+  inTransaction = true;
+
+  uint16_t line[64];
+  int32_t  i, j, byteWidth = (w + 7) / 8;
+
+  setWindow(x, y, x + w - 1, y + h - 1);
+
+  for (j = 0; j < h; j++) {
+    const uint8_t *row = bitmap + j * byteWidth;
+    uint8_t bits = 0, n = 0;
+
+    for (i = 0; i < w; i++) {
+      if (!(i & 7)) bits = pgm_read_byte(row + (i >> 3));
+      line[n++] = (bits & (128 >> (i & 7))) ? fgcolor : bgcolor;
+      if (n == 64) { pushColors(line, n); n = 0; }
+    }
+    if (n) pushColors(line, n);
+  }
+
+  inTransaction = false;
+  spi_end();
+}
+
+
+/***************************************************************************************
+** Function name:           drawRLE
+** Description:             Draw a run length encoded image stored in FLASH
+***************************************************************************************/
+// Same format as the RLE fonts: each byte is a run of (bits 0-6) + 1 pixels, bit 7 set
+// for fgcolor. Runs continue over the row ends. The image is transparent if fgcolor
+// equals bgcolor, otherwise the runs of both colours are streamed into one window.
+
+void TFT_eSPI::drawRLE(int32_t x, int32_t y, const uint8_t *rle, int32_t w, int32_t h, uint32_t fgcolor, uint32_t bgcolor)
+{
+  int32_t pc = w * h; // Pixels left
+
+  spi_begin();
+  inTransaction = true;
+
+  if ((fgcolor != bgcolor) && (x >= 0) && (y >= 0) && (x + w <= (int32_t)_width) && (y + h <= (int32_t)_height)) {
+    setAddrWindow(x, y, x + w - 1, y + h - 1);
+    while (pc > 0) {
+      uint8_t line = pgm_read_byte(rle++);
+      pc -= (line & 0x7F) + 1;
+      spiWriteBlock((line & 0x80) ? fgcolor : bgcolor, (line & 0x7F) + 1);
+    }
+    CS_H;
+  }
+  else {
+    if (fgcolor != bgcolor) fillRect(x, y, w, h, bgcolor);
+    int32_t px = 0, py = y;
+    while (pc > 0) {
+      uint8_t line = pgm_read_byte(rle++);
+      int32_t n = (line & 0x7F) + 1;
+      pc -= n;
+      // Foreground runs are split at the row ends
+      while (n > 0) {
+        int32_t len = (n < w - px) ? n : w - px;
+        if ((line & 0x80) && (py >= 0)) {
+          // drawFastHLine() does not clip on the left
+          int32_t xs = x + px, xl = len;
+          if (xs < 0) { xl += xs; xs = 0; }
+          if (xl > 0) drawFastHLine(xs, py, xl, fgcolor);
+        }
+        n -= len;
+        px += len;
+        if (px == w) { px = 0; py++; }
       }
     }
   }
@@ -1321,6 +1480,7 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, u
     byte mask = 0x1;
     spi_begin();
     setAddrWindow(x, y, x+5, y+8);
+    SPI_STAT(6 * 8 * 2);
     for (int8_t i = 0; i < 5; i++ ) column[i] = pgm_read_byte(font + (c * 5) + i);
     column[5] = 0;
 
@@ -1424,6 +1584,17 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, u
     uint8_t  xx, yy, bits, bit=0;
     int16_t  xo16, yo16;
 
+#ifdef GLYPH_CACHE
+    // A cached glyph is drawn from RAM, transparent like the FLASH path below
+    cachedGlyph *cg = (size == 1) ? getCachedGlyph(gfxFont, c) : NULL;
+    if (cg) {
+      drawGlyphBits(x + xo, y + yo, cg->bits, w, h, color);
+      inTransaction = false;
+      spi_end();
+      return;
+    }
+#endif
+
     if(size > 1) {
       xo16 = xo;
       yo16 = yo;
@@ -1544,6 +1715,87 @@ void TFT_eSPI::drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, u
 }
 
 
+#if defined (LOAD_GFXFF) && defined (GLYPH_CACHE)
+/***************************************************************************************
+** Function name:           getCachedGlyph
+** Description:             find a glyph in the RAM cache, unpack it from FLASH if missing
+***************************************************************************************/
+// Returns NULL if the glyph is too big for an entry, it is then drawn from FLASH
+
+static cachedGlyph *getCachedGlyph(const GFXfont *font, uint8_t c)
+{
+  cachedGlyph *g = glyphCache, *lru = glyphCache;
+
+  for (uint8_t i = 0; i < GLYPH_CACHE; i++, g++) {
+    if ((g->font == font) && (g->c == c)) {
+      g->used = ++glyphUseCount;
+      return g;
+    }
+    if (g->used < lru->used) lru = g;
+  }
+
+  GFXglyph *glyph  = &(((GFXglyph *)pgm_read_dword(&font->glyph))[c]);
+  uint8_t  *bitmap = (uint8_t *)pgm_read_dword(&font->bitmap);
+
+  uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+  uint8_t  w  = pgm_read_byte(&glyph->width),
+           h  = pgm_read_byte(&glyph->height);
+  uint8_t  bpr = (w + 7) >> 3; // Bytes per row
+
+  if (bpr * h > GLYPH_CACHE_BYTES) return NULL;
+
+  lru->font = font;
+  lru->c    = c;
+  lru->w    = w;
+  lru->h    = h;
+  lru->xo   = pgm_read_byte(&glyph->xOffset);
+  lru->yo   = pgm_read_byte(&glyph->yOffset);
+  lru->used = ++glyphUseCount;
+
+  // The FLASH bitmap is one bit stream, rows are aligned to bytes here
+  memset(lru->bits, 0, bpr * h);
+  uint8_t bits = 0, bit = 0;
+  for (uint8_t yy = 0; yy < h; yy++) {
+    uint8_t *row = lru->bits + yy * bpr;
+    for (uint8_t xx = 0; xx < w; xx++) {
+      if (bit == 0) {
+        bits = pgm_read_byte(&bitmap[bo++]);
+        bit  = 0x80;
+      }
+      if (bits & bit) row[xx >> 3] |= 0x80 >> (xx & 7);
+      bit >>= 1;
+    }
+  }
+
+  return lru;
+}
+
+
+/***************************************************************************************
+** Function name:           drawGlyphBits
+** Description:             draw a cached glyph as horizontal runs
+***************************************************************************************/
+// Works for the TFT and sprites. The background is not drawn, as for glyphs
+// that are not cached.
+
+void TFT_eSPI::drawGlyphBits(int32_t x, int32_t y, const uint8_t *bits, uint8_t w, uint8_t h, uint32_t color)
+{
+  uint8_t bpr = (w + 7) >> 3;
+
+  for (uint8_t yy = 0; yy < h; yy++, bits += bpr) {
+    uint8_t xx = 0;
+    while (xx < w) {
+      // Skip the background, then measure the run of set pixels
+      while ((xx < w) && !(bits[xx >> 3] & (0x80 >> (xx & 7)))) xx++;
+      uint8_t xs = xx;
+      while ((xx < w) && (bits[xx >> 3] & (0x80 >> (xx & 7)))) xx++;
+      if (xx > xs) drawFastHLine(x + xs, y + yy, xx - xs, color);
+    }
+  }
+}
+#endif
+
+
 /***************************************************************************************
 ** Function name:           setWindow
 ** Description:             define an area to receive a stream of pixels
@@ -1569,6 +1821,7 @@ void TFT_eSPI::setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
 inline void TFT_eSPI::setAddrWindow(int32_t xs, int32_t ys, int32_t xe, int32_t ye)
 {
   //spi_begin();
+  SPI_STAT(11); // 3 commands and 8 coordinate bytes
 
   addr_col = 0xFFFF;
   addr_row = 0xFFFF;
@@ -1636,6 +1889,7 @@ inline void TFT_eSPI::setAddrWindow(int32_t xs, int32_t ys, int32_t xe, int32_t
 void TFT_eSPI::setAddrWindow(int32_t xs, int32_t ys, int32_t xe, int32_t ye)
 {
   //spi_begin();
+  SPI_STAT(11); // 3 commands and 8 coordinate bytes
 
   addr_col = 0xFFFF;
   addr_row = 0xFFFF;
@@ -1691,6 +1945,7 @@ void TFT_eSPI::setAddrWindow(int32_t xs, int32_t ys, int32_t xe, int32_t ye)
 inline void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
   //spi_begin();
+  SPI_STAT(11); // 3 commands and 8 coordinate bytes
 
   CS_L;
   uint32_t mask = ~((SPIMMOSI << SPILMOSI) | (SPIMMISO << SPILMISO));
@@ -1768,6 +2023,7 @@ inline void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t x1, int32_t
 inline void TFT_eSPI::setAddrWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
 {
   //spi_begin();
+  SPI_STAT(11); // 3 commands and 8 coordinate bytes
 
   addr_col = 0xFFFF;
   addr_row = 0xFFFF;
@@ -1981,6 +2237,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
   // No need to send x if it has not changed (speeds things up)
   if (addr_col != x) {
 
+    SPI_STAT(5);
     DC_C;
 
     SPI1U1 = mask | (CMD_BITS << SPILMOSI) | (CMD_BITS << SPILMISO);
@@ -2008,6 +2265,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
   // No need to send y if it has not changed (speeds things up)
   if (addr_row != y) {
 
+    SPI_STAT(5);
     DC_C;
 
     SPI1U1 = mask | (CMD_BITS << SPILMOSI) | (CMD_BITS << SPILMISO);
@@ -2033,6 +2291,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
     addr_row = y;
   }
 
+  SPI_STAT(3);
   DC_C;
 
   SPI1U1 = mask | (CMD_BITS << SPILMOSI) | (CMD_BITS << SPILMISO);
@@ -2164,6 +2423,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
   // No need to send x if it has not changed (speeds things up)
   if (addr_col != x) {
 
+    SPI_STAT(5);
     DC_C;
 
 #if defined (RPI_ILI9486_DRIVER)
@@ -2187,6 +2447,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
   // No need to send y if it has not changed (speeds things up)
   if (addr_row != y) {
 
+    SPI_STAT(5);
     DC_C;
 
 #if defined (RPI_ILI9486_DRIVER)
@@ -2207,6 +2468,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
     addr_row = y;
   }
 
+  SPI_STAT(3);
   DC_C;
 
 #if defined (RPI_ILI9486_DRIVER)
@@ -2233,6 +2495,7 @@ void TFT_eSPI::drawPixel(uint32_t x, uint32_t y, uint32_t color)
 ***************************************************************************************/
 void TFT_eSPI::pushColor(uint16_t color)
 {
+  SPI_STAT(2);
   spi_begin();
 
   CS_L;
@@ -2280,6 +2543,7 @@ void TFT_eSPI::pushColor(uint16_t color, uint16_t len)
 
 void TFT_eSPI::pushColors(uint16_t *data, uint8_t len)
 {
+  SPI_STAT(2 * len);
   spi_begin();
 
   CS_L;
@@ -2340,6 +2604,7 @@ void TFT_eSPI::pushColors(uint16_t *data, uint8_t len)
 
 void TFT_eSPI::pushColors(uint8_t *data, uint32_t len)
 {
+  SPI_STAT(len);
   spi_begin();
 
   CS_L;
@@ -2427,13 +2692,44 @@ void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t
 
 #else
 
-// This is a weeny bit faster
+// Runs are filled as one window and burst each, see drawLineRuns()
 void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+{
+  drawThickLine(x0, y0, x1, y1, 1, color);
+}
+#endif
+
+
+/***************************************************************************************
+** Function name:           drawThickLine
+** Description:             draw a line "thickness" pixels wide
+***************************************************************************************/
+// The line is widened across its minor axis: shallow lines get taller, steep lines
+// wider. A bold polyline is drawn in a single pass with no overdrawn pixels.
+void TFT_eSPI::drawThickLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color)
 {
   spi_begin();
+  inTransaction = true;
 
-  boolean steep = abs(y1 - y0) > abs(x1 - x0);
+  drawLineRuns(x0, y0, x1, y1, thickness, color);
+
+  inTransaction = false;
+  spi_end();
+}
+
+
+/***************************************************************************************
+** Function name:           drawLineRuns
+** Description:             draw a line as horizontal or vertical runs
+***************************************************************************************/
+// Bresenham's algorithm collecting the pixels of one minor axis step into a run.
+// Each run is a thickness x length rectangle sent with one fillRect(), so a line
+// costs one address window per step and no command per pixel.
+void TFT_eSPI::drawLineRuns(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color)
+{
+  if (thickness < 1) return;
 
+  boolean steep = abs(y1 - y0) > abs(x1 - x0);
   if (steep) {
     swap_coord(x0, y0);
     swap_coord(x1, y1);
@@ -2444,95 +2740,170 @@ void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t
     swap_coord(y0, y1);
   }
 
-  if (x1 < 0) return;
+  int32_t dx = x1 - x0, dy = abs(y1 - y0);
+
+  int32_t err = dx >> 1, ystep = -1, xs = x0, half = thickness >> 1;
 
-  int16_t dx, dy;
-  dx = x1 - x0;
-  dy = abs(y1 - y0);
+  if (y0 < y1) ystep = 1;
 
-  int16_t err = dx / 2;
-  int8_t ystep = (y0 < y1) ? 1 : (-1);
+  // Nothing after the end of the major axis can be seen
+  int32_t major = steep ? _height : _width;
+  if ((x1 < 0) || (x0 >= major)) return;
+  if (x1 >= major) x1 = major - 1;
+
+  for (; x0 <= x1; x0++) {
+    err -= dy;
+    if ((err < 0) || (x0 == x1)) {
+      if (steep) fillLineRun(y0 - half, xs, thickness, x0 - xs + 1, color);
+      else       fillLineRun(xs, y0 - half, x0 - xs + 1, thickness, color);
+      err += dx; y0 += ystep; xs = x0 + 1;
+    }
+  }
+}
 
-  uint32_t mask = ~((SPIMMOSI << SPILMOSI) | (SPIMMISO << SPILMISO));
-  mask = (SPI1U1 & mask) | (15 << SPILMOSI) | (15 << SPILMISO);
-  SPI1U = SPIUMOSI | SPIUSSE;
-  int16_t swapped_color = (color >> 8) | (color << 8);
 
-  if (steep)  // y increments every iteration (y0 is x-axis, and x0 is y-axis)
-  {
-    if (x1 >= _height) x1 = _height - 1;
+/***************************************************************************************
+** Function name:           fillLineRun
+** Description:             fill one run clipped to the screen
+***************************************************************************************/
+// fillRect() of the TFT does not clip on the left or top
+void TFT_eSPI::fillLineRun(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > (int32_t)_width)  w = _width  - x;
+  if (y + h > (int32_t)_height) h = _height - y;
+  if ((w < 1) || (h < 1)) return;
 
-    for (; x0 <= x1; x0++) {
-      if ((x0 >= 0) && (y0 >= 0) && (y0 < _width)) break;
-      err -= dy;
-      if (err < 0) {
-        err += dx;
-        y0 += ystep;
-      }
-    }
+  fillRect(x, y, w, h, color);
+}
 
-    if (x0 > x1) return;
 
-    setAddrWindow(y0, x0, y0, _height);
-    SPI1U1 = mask;
-    SPI1W0 = swapped_color;
-    for (; x0 <= x1; x0++) {
-      while(SPI1CMD & SPIBUSY) {}
-      SPI1CMD |= SPIBUSY;
+/***************************************************************************************
+** Function name:           drawPolyline
+** Description:             draw a line through evenly spaced samples
+***************************************************************************************/
+// Sample i is at (x + i * dx, y[i]), the segments are drawn as runs by drawLineRuns()
+void TFT_eSPI::drawPolyline(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t thickness, uint32_t color)
+{
+  spi_begin();
+  inTransaction = true;
 
-      err -= dy;
-      if (err < 0) {
-        y0 += ystep;
-        if ((y0 < 0) || (y0 >= _width)) break;
-        err += dx;
-        while(SPI1CMD & SPIBUSY) {}
-        setAddrWindow(y0, x0+1, y0, _height);
-        SPI1U1 = mask;
-        SPI1W0 = swapped_color;
+  for (uint16_t i = 1; i < n; i++, x += dx)
+    drawLineRuns(x, y[i - 1], x + dx, y[i], thickness, color);
+
+  inTransaction = false;
+  spi_end();
+}
+
+
+/***************************************************************************************
+** Function name:           fillAreaUnderCurve
+** Description:             fill between evenly spaced samples and a baseline
+***************************************************************************************/
+// The curve is interpolated for every column and columns with the same top are
+// filled as one rectangle, so a flat stretch of the curve is a single window.
+// The area ends before the last sample and the baseline row, like fillRect().
+void TFT_eSPI::fillAreaUnderCurve(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t baseline, uint32_t color)
+{
+  if ((n < 2) || (dx < 1)) return;
+
+  spi_begin();
+  inTransaction = true;
+
+  int32_t xs = x, top = y[0];
+
+  for (uint16_t i = 1; i < n; i++, x += dx) {
+    int32_t dy = y[i] - y[i - 1];
+    for (int32_t j = 0; j < dx; j++) {
+      int32_t yc = y[i - 1] + (2 * dy * j + ((dy < 0) ? -dx : dx)) / (2 * dx);
+      if (yc != top) {
+        fillLineRun(xs, top, x + j - xs, baseline - top, color);
+        xs = x + j; top = yc;
       }
     }
   }
-  else    // x increments every iteration (x0 is x-axis, and y0 is y-axis)
-  {
-    if (x1 >= _width) x1 = _width - 1;
+  fillLineRun(xs, top, x - xs, baseline - top, color);
 
-    for (; x0 <= x1; x0++) {
-      if ((x0 >= 0) && (y0 >= 0) && (y0 < _height)) break;
-      err -= dy;
-      if (err < 0) {
-          err += dx;
-          y0 += ystep;
-      }
-    }
+  inTransaction = false;
+  spi_end();
+}
 
-    if (x0 > x1) return;
 
-    setAddrWindow(x0, y0, _width, y0);
-    SPI1U1 = mask;
-    SPI1W0 = swapped_color;
-    for (; x0 <= x1; x0++) {
-      while(SPI1CMD & SPIBUSY) {}
-      SPI1CMD |= SPIBUSY;
+/***************************************************************************************
+** Function name:           drawBars
+** Description:             draw a bar from every sample down to a baseline
+***************************************************************************************/
+// Bar i starts at x + i * dx and is w pixels wide, touching bars of the same height
+// are filled together
+void TFT_eSPI::drawBars(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t w, int32_t baseline, uint32_t color)
+{
+  if ((n < 1) || (w < 1)) return;
 
-      err -= dy;
-      if (err < 0) {
-        y0 += ystep;
-        if ((y0 < 0) || (y0 >= _height)) break;
-        err += dx;
-        while(SPI1CMD & SPIBUSY) {}
-        setAddrWindow(x0+1, y0, _width, y0);
-        SPI1U1 = mask;
-		SPI1W0 = swapped_color;
-      }
+  spi_begin();
+  inTransaction = true;
+
+  int32_t xs = x, bw = w;
+
+  for (uint16_t i = 1; i <= n; i++) {
+    if ((i < n) && (w >= dx) && (y[i] == y[i - 1])) {
+      bw += dx;
+      continue;
     }
+    fillLineRun(xs, y[i - 1], bw, baseline - y[i - 1], color);
+    xs = x + i * dx; bw = w;
   }
 
-  while(SPI1CMD & SPIBUSY) {}
-  SPI1U = SPIUMOSI | SPIUDUPLEX | SPIUSSE;
-  CS_H;
+  inTransaction = false;
   spi_end();
 }
-#endif
+
+
+/***************************************************************************************
+** Function name:           sinQ15
+** Description:             sine of a binary angle as a Q15 fraction
+***************************************************************************************/
+// A turn has 256 steps, so angles wrap in a uint8_t. Only the first quarter wave is
+// stored, the rest is mirrored from it.
+static const int16_t sinQ15Table[65] PROGMEM = {
+      0,   804,  1608,  2411,  3212,  4011,  4808,  5602,
+   6393,  7180,  7962,  8740,  9512, 10279, 11039, 11793,
+  12540, 13279, 14010, 14733, 15447, 16151, 16846, 17531,
+  18205, 18868, 19520, 20160, 20788, 21403, 22006, 22595,
+  23170, 23732, 24279, 24812, 25330, 25833, 26320, 26791,
+  27246, 27684, 28106, 28511, 28899, 29269, 29622, 29957,
+  30274, 30572, 30853, 31114, 31357, 31581, 31786, 31972,
+  32138, 32286, 32413, 32522, 32610, 32679, 32729, 32758,
+  32767
+};
+
+int16_t sinQ15(uint8_t angle)
+{
+  uint8_t i = angle & 0x3F;
+  if (angle & 0x40) i = 64 - i;
+  int16_t v = pgm_read_word(&sinQ15Table[i]);
+  return (angle & 0x80) ? -v : v;
+}
+
+
+/***************************************************************************************
+** Function name:           cosQ15
+** Description:             cosine of a binary angle as a Q15 fraction
+***************************************************************************************/
+int16_t cosQ15(uint8_t angle)
+{
+  return sinQ15(angle + 64);
+}
+
+
+/***************************************************************************************
+** Function name:           mulQ15
+** Description:             scale a length by a Q15 fraction, rounded
+***************************************************************************************/
+int32_t mulQ15(int32_t r, int16_t q15)
+{
+  return (r * q15 + 0x4000) >> 15;
+}
 
 
 /***************************************************************************************
@@ -2972,6 +3343,7 @@ int16_t TFT_eSPI::drawChar(unsigned int uniCode, int x, int y, int font)
     {
       spi_begin();
       setAddrWindow(x, y, (x + w * 8) - 1, y + height - 1);
+      SPI_STAT(w * 8 * height * 2);
 
       byte mask;
       for (int i = 0; i < height; i++)
@@ -3038,6 +3410,7 @@ int16_t TFT_eSPI::drawChar(unsigned int uniCode, int x, int y, int font)
           while (line--) { // In this case the while(line--) is faster
             pc++; // This is faster than putting pc+=line before while()?
             setAddrWindow(px, py, px + ts, py + ts);
+            SPI_STAT(2 * np);
 
             if (ts) {
               tnp = np;
@@ -3533,6 +3906,7 @@ void TFT_eSPI::setTextFont(uint8_t f)
 #if defined (ESP8266) && (SPI_FREQUENCY != 80000000)
 void spiWriteBlock(uint16_t color, uint32_t repeat)
 {
+  SPI_STAT(2 * repeat);
   uint16_t color16 = (color >> 8) | (color << 8);
   uint32_t color32 = color16 | color16 << 16;
   uint32_t mask = ~(SPIMMOSI << SPILMOSI);
@@ -3591,6 +3965,7 @@ void spiWriteBlock(uint16_t color, uint32_t repeat)
 #define BUFFER_SIZE 64
 void spiWriteBlock(uint16_t color, uint32_t repeat)
 {
+  SPI_STAT(2 * repeat);
 
   uint8_t colorBin[] = { (uint8_t) (color >> 8), (uint8_t) color};
   SPI.writePattern(&colorBin[0], 2, repeat);
@@ -3604,6 +3979,7 @@ void spiWriteBlock(uint16_t color, uint32_t repeat)
 
 void spiWriteBlock(uint16_t color, uint32_t repeat)
 {
+  SPI_STAT(2 * repeat);
   uint16_t color16 = (color >> 8) | (color << 8);
   uint32_t color32 = color16 | color16 << 16;
 
@@ -3633,6 +4009,992 @@ void spiWriteBlock(uint16_t color, uint32_t repeat)
 }
 #endif
 
+/***************************************************************************************
+** Function name:           TFT_eSprite
+** Description:             Class constructor
+***************************************************************************************/
+TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
+{
+  _tft = tft;
+  _img = NULL;
+
+  _iwidth  = _iheight = 0;
+  _xorg    = _yorg = 0;
+  _harea   = 0;
+  _yband   = 0;
+  _xs = _ys = _xe = _ye = 0;
+  _xptr = _yptr = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eSprite
+** Description:             Class destructor, releases the RAM buffer
+***************************************************************************************/
+TFT_eSprite::~TFT_eSprite(void)
+{
+  deleteSprite();
+}
+
+
+/***************************************************************************************
+** Function name:           createSprite
+** Description:             Allocate the RAM buffer, returns NULL if out of memory
+***************************************************************************************/
+// If bandHeight is between 1 and h-1 only w x bandHeight pixels are allocated and
+// the canvas is drawn one band at a time, see selectBand()
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, int16_t bandHeight)
+{
+  if (_img) deleteSprite();
+  if ((w < 1) || (h < 1)) return NULL;
+
+  if ((bandHeight < 1) || (bandHeight > h)) bandHeight = h;
+
+  _img = (uint16_t*) malloc((uint32_t)w * bandHeight * 2);
+  if (!_img) return NULL;
+
+  _width   = w;           // Canvas size, used for clipping by the inherited functions
+  _height  = h;
+  _iwidth  = w;           // Buffer size
+  _iheight = bandHeight;
+  _xorg    = _yorg = 0;
+  _harea   = h;
+  _yband   = 0;
+
+  setWindow(0, 0, w - 1, h - 1);
+
+  return _img;
+}
+
+
+/***************************************************************************************
+** Function name:           createWindow
+** Description:             Allocate a buffer for an area of the TFT
+***************************************************************************************/
+// The canvas is the whole TFT so existing screen drawing code can be pointed at
+// the sprite unchanged, anything outside the x,y,w,h area is clipped
+void* TFT_eSprite::createWindow(int32_t x, int32_t y, int16_t w, int16_t h, int16_t bandHeight)
+{
+  if (!createSprite(w, h, bandHeight)) return NULL;
+
+  _width  = _tft->width();
+  _height = _tft->height();
+  _xorg   = x;
+  _yorg   = y;
+  _yband  = y;
+
+  setWindow(x, y, x + w - 1, y + h - 1);
+
+  return _img;
+}
+
+
+/***************************************************************************************
+** Function name:           deleteSprite
+** Description:             Release the RAM buffer
+***************************************************************************************/
+void TFT_eSprite::deleteSprite(void)
+{
+  if (_img) free(_img);
+  _img = NULL;
+  _iwidth = _iheight = 0;
+}
+
+
+/***************************************************************************************
+** Function name:           created
+** Description:             Returns true if a buffer has been allocated
+***************************************************************************************/
+boolean TFT_eSprite::created(void)
+{
+  return _img != NULL;
+}
+
+
+/***************************************************************************************
+** Function name:           bands
+** Description:             Number of bands needed to render the whole canvas
+***************************************************************************************/
+uint8_t TFT_eSprite::bands(void)
+{
+  if (!_img) return 0;
+  return (_harea + _iheight - 1) / _iheight;
+}
+
+
+/***************************************************************************************
+** Function name:           selectBand
+** Description:             Select the canvas rows that will be held in the buffer
+***************************************************************************************/
+// Drawing coordinates are always canvas coordinates, anything outside the selected
+// band is clipped. The buffer contents are not cleared.
+void TFT_eSprite::selectBand(uint8_t band)
+{
+  if (band >= bands()) return;
+  _yband = _yorg + (int32_t)band * _iheight;
+}
+
+
+/***************************************************************************************
+** Function name:           fillSprite
+** Description:             Fill the buffer (the selected band) with a colour
+***************************************************************************************/
+void TFT_eSprite::fillSprite(uint32_t color)
+{
+  fillRect(_xorg, _yband, _iwidth, _iheight, color);
+}
+
+
+/***************************************************************************************
+** Function name:           pushSprite
+** Description:             Send the buffer to the TFT with its top left corner at x,y
+***************************************************************************************/
+// In banded mode the selected band is pushed to its position within the area
+void TFT_eSprite::pushSprite(int32_t x, int32_t y)
+{
+  if (!_img) return;
+
+  int32_t rows = _yorg + _harea - _yband;  // Last band may be partly used
+  if (rows > _iheight) rows = _iheight;
+
+  y += _yband - _yorg;
+
+  int32_t xs = 0, ys = 0, w = _iwidth;
+
+  // Clip to the TFT
+  if (x < 0) { xs = -x; w += x; x = 0; }
+  if (y < 0) { ys = -y; rows += y; y = 0; }
+  if (x + w > _tft->width())     w = _tft->width()  - x;
+  if (y + rows > _tft->height()) rows = _tft->height() - y;
+  if ((w < 1) || (rows < 1)) return;
+
+  if (w == _iwidth)
+  {
+    // One window and one burst for the whole buffer
+    _tft->pushRect(x, y, w, rows, _img + ys * _iwidth);
+  }
+  else
+  {
+    // Rows are not contiguous in the buffer so send one row at a time
+    for (int32_t row = 0; row < rows; row++)
+      _tft->pushRect(x, y + row, w, 1, _img + (ys + row) * _iwidth + xs);
+  }
+}
+
+void TFT_eSprite::pushSprite(void)
+{
+  pushSprite(_xorg, _yorg);
+}
+
+
+/***************************************************************************************
+** Function name:           writePPM
+** Description:             Write the buffer as a binary PPM image
+***************************************************************************************/
+void TFT_eSprite::writePPM(Print &out)
+{
+  if (!_img) return;
+
+  int32_t rows = _yorg + _harea - _yband;
+  if (rows > _iheight) rows = _iheight;
+
+  out.print("P6\n");
+  out.print(String(_iwidth) + " " + String(rows) + "\n255\n");
+
+  uint8_t rgb[3];
+  uint16_t *p = _img;
+  for (int32_t i = 0; i < _iwidth * rows; i++)
+  {
+    uint16_t color = (*p >> 8) | (*p << 8); // Undo the byte swap
+    p++;
+    rgb[0] = (color >> 8) & 0xF8; rgb[0] |= rgb[0] >> 5;
+    rgb[1] = (color >> 3) & 0xFC; rgb[1] |= rgb[1] >> 6;
+    rgb[2] = (color << 3) & 0xF8; rgb[2] |= rgb[2] >> 5;
+    out.write(rgb, 3);
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           readPixel
+** Description:             Read the 565 colour of a pixel in the buffer
+***************************************************************************************/
+uint16_t TFT_eSprite::readPixel(int32_t x, int32_t y)
+{
+  x -= _xorg;
+  y -= _yband;
+  if (!_img || (x < 0) || (y < 0) || (x >= _iwidth) || (y >= _iheight)) return 0;
+
+  uint16_t color = _img[x + y * _iwidth];
+  return (color >> 8) | (color << 8);
+}
+
+
+/***************************************************************************************
+** Function name:           getPointer
+** Description:             Returns a pointer to the pixel buffer (byte swapped 565)
+***************************************************************************************/
+uint16_t* TFT_eSprite::getPointer(void)
+{
+  return _img;
+}
+
+
+/***************************************************************************************
+** Function name:           drawPixel
+** Description:             Set a pixel in the buffer
+***************************************************************************************/
+void TFT_eSprite::drawPixel(uint32_t x, uint32_t y, uint32_t color)
+{
+  int32_t xs = (int32_t)x - _xorg;
+  int32_t ys = (int32_t)y - _yband;
+
+  if (!_img || (xs < 0) || (ys < 0) || (xs >= _iwidth) || (ys >= _iheight)) return;
+
+  _img[xs + ys * _iwidth] = (uint16_t)((color >> 8) | (color << 8));
+}
+
+
+/***************************************************************************************
+** Function name:           fillRect
+** Description:             Fill a clipped rectangle in the buffer
+***************************************************************************************/
+void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if (!_img) return;
+
+  x -= _xorg;
+  y -= _yband;
+
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > _iwidth)  w = _iwidth  - x;
+  if (y + h > _iheight) h = _iheight - y;
+  if ((w < 1) || (h < 1)) return;
+
+  uint16_t color16 = (color >> 8) | (color << 8);
+  uint16_t *row = _img + x + y * _iwidth;
+
+  while (h--)
+  {
+    uint16_t *p = row;
+    int32_t n = w;
+    while (n--) *p++ = color16;
+    row += _iwidth;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           drawFastVLine
+** Description:             draw a vertical line in the buffer
+***************************************************************************************/
+void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawFastHLine
+** Description:             draw a horizontal line in the buffer
+***************************************************************************************/
+void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawLine
+** Description:             draw a line between 2 arbitrary points
+***************************************************************************************/
+// The runs are filled in the buffer, no SPI transaction is needed
+void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color)
+{
+  drawLineRuns(x0, y0, x1, y1, 1, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawThickLine
+** Description:             draw a line "thickness" pixels wide
+***************************************************************************************/
+void TFT_eSprite::drawThickLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color)
+{
+  drawLineRuns(x0, y0, x1, y1, thickness, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawBitmap
+** Description:             Draw an image with a background colour into the buffer
+***************************************************************************************/
+void TFT_eSprite::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor)
+{
+  fillRect(x, y, w, h, bgcolor);
+  TFT_eSPI::drawBitmap(x, y, bitmap, w, h, fgcolor);
+}
+
+
+/***************************************************************************************
+** Function name:           drawRLE
+** Description:             Draw a run length encoded image into the buffer
+***************************************************************************************/
+void TFT_eSprite::drawRLE(int32_t x, int32_t y, const uint8_t *rle, int32_t w, int32_t h, uint32_t fgcolor, uint32_t bgcolor)
+{
+  if (fgcolor != bgcolor) fillRect(x, y, w, h, bgcolor);
+  TFT_eSPI::drawRLE(x, y, rle, w, h, fgcolor, fgcolor);
+}
+
+
+/***************************************************************************************
+** Function name:           setWindow
+** Description:             Set the area that pushColor() writes to
+***************************************************************************************/
+void TFT_eSprite::setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  if (x0 > x1) swap_coord(x0, x1);
+  if (y0 > y1) swap_coord(y0, y1);
+
+  _xs = x0; _ys = y0;
+  _xe = x1; _ye = y1;
+
+  _xptr = _xs;
+  _yptr = _ys;
+}
+
+
+/***************************************************************************************
+** Function name:           pushColor
+** Description:             Write one pixel at the window pointer and advance it
+***************************************************************************************/
+void TFT_eSprite::pushColor(uint16_t color)
+{
+  drawPixel(_xptr, _yptr, color);
+
+  if (++_xptr > _xe) {
+    _xptr = _xs;
+    if (++_yptr > _ye) _yptr = _ys;
+  }
+}
+
+
+/***************************************************************************************
+** Function name:           pushColor
+** Description:             Write "len" pixels of one colour into the window
+***************************************************************************************/
+void TFT_eSprite::pushColor(uint16_t color, uint16_t len)
+{
+  while (len--) pushColor(color);
+}
+
+
+/***************************************************************************************
+** Function name:           pushColors
+** Description:             Write an array of pixels into the window
+***************************************************************************************/
+void TFT_eSprite::pushColors(uint16_t *data, uint8_t len)
+{
+  while (len--) pushColor(*data++);
+}
+
+
+/***************************************************************************************
+** Function name:           drawChar
+** Description:             draw a single character in the GLCD or GFXFF font
+***************************************************************************************/
+void TFT_eSprite::drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, uint32_t bg, uint8_t size)
+{
+  if (!_img) return;
+
+#ifdef LOAD_GLCD
+#ifdef LOAD_GFXFF
+  if(!gfxFont) { // 'Classic' built-in font
+#endif
+
+  if ((x >= (int32_t)_width) || (y >= (int32_t)_height) ||
+      ((x + 6 * size - 1) < 0) || ((y + 8 * size - 1) < 0))
+    return;
+
+  boolean fillbg = (bg != color);
+
+  for (int8_t i = 0; i < 6; i++ ) {
+    uint8_t line;
+    if (i == 5)
+      line = 0x0;
+    else
+      line = pgm_read_byte(font + (c * 5) + i);
+
+    for (int8_t j = 0; j < 8; j++) {
+      if (line & 0x1) fillRect(x + i * size, y + j * size, size, size, color);
+      else if (fillbg) fillRect(x + i * size, y + j * size, size, size, bg);
+      line >>= 1;
+    }
+  }
+
+#ifdef LOAD_GFXFF
+  } else { // Custom font
+#endif
+#endif // LOAD_GLCD
+
+#ifdef LOAD_GFXFF
+    if (c > pgm_read_byte(&gfxFont->last)) c = pgm_read_byte(&gfxFont->first);
+    c -= pgm_read_byte(&gfxFont->first);
+    GFXglyph *glyph  = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[c]);
+    uint8_t  *bitmap = (uint8_t *)pgm_read_dword(&gfxFont->bitmap);
+
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t  w  = pgm_read_byte(&glyph->width),
+             h  = pgm_read_byte(&glyph->height);
+    int8_t   xo = pgm_read_byte(&glyph->xOffset),
+             yo = pgm_read_byte(&glyph->yOffset);
+    uint8_t  xx, yy, bits = 0, bit = 0;
+    int16_t  hpc = 0; // Horizontal foreground pixel count
+
+#ifdef GLYPH_CACHE
+    cachedGlyph *cg = (size == 1) ? getCachedGlyph(gfxFont, c) : NULL;
+    if (cg) {
+      drawGlyphBits(x + xo, y + yo, cg->bits, w, h, color);
+      return;
+    }
+#endif
+
+    // Rows are scanned for runs of set pixels, each run is one fillRect()
+    for(yy=0; yy<h; yy++) {
+      for(xx=0; xx<w; xx++) {
+        if(bit == 0) {
+          bits = pgm_read_byte(&bitmap[bo++]);
+          bit  = 0x80;
+        }
+        if(bits & bit) hpc++;
+        else if (hpc) {
+          fillRect(x+(xo+xx-hpc)*size, y+(yo+yy)*size, size*hpc, size, color);
+          hpc=0;
+        }
+        bit >>= 1;
+      }
+      if (hpc) {
+        fillRect(x+(xo+xx-hpc)*size, y+(yo+yy)*size, size*hpc, size, color);
+        hpc=0;
+      }
+    }
+#endif
+
+#ifdef LOAD_GLCD
+  #ifdef LOAD_GFXFF
+  } // End classic vs custom font
+  #endif
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           drawChar
+** Description:             draw a unicode into the buffer
+***************************************************************************************/
+int16_t TFT_eSprite::drawChar(unsigned int uniCode, int x, int y)
+{
+  return drawChar(uniCode, x, y, textfont);
+}
+
+int16_t TFT_eSprite::drawChar(unsigned int uniCode, int x, int y, int font)
+{
+  if (font==1)
+  {
+    drawChar(x, y, uniCode, textcolor, textbgcolor, textsize);
+#ifdef LOAD_GFXFF
+    if(gfxFont)
+    {
+      if (uniCode > pgm_read_byte(&gfxFont->last)) uniCode = pgm_read_byte(&gfxFont->first);
+
+      if(uniCode < pgm_read_byte(&gfxFont->first)) return 0;
+
+      uint8_t   c2    = uniCode - pgm_read_byte(&gfxFont->first);
+      GFXglyph *glyph = &(((GFXglyph *)pgm_read_dword(&gfxFont->glyph))[c2]);
+      return pgm_read_byte(&glyph->xAdvance) * textsize;
+    }
+#endif
+#ifdef LOAD_GLCD
+    return 6 * textsize;
+#else
+    return 0;
+#endif
+  }
+
+  int width  = 0;
+  int height = 0;
+  uint32_t flash_address = 0;
+  uniCode -= 32;
+
+#ifdef LOAD_FONT2
+  if (font == 2)
+  {
+    flash_address = pgm_read_dword(&chrtbl_f16[uniCode]);
+    width = pgm_read_byte(widtbl_f16 + uniCode);
+    height = chr_hgt_f16;
+  }
+  #ifdef LOAD_RLE
+  else
+  #endif
+#endif
+
+#ifdef LOAD_RLE
+  {
+    if ((font>2) && (font<9))
+    {
+      flash_address = pgm_read_dword( pgm_read_dword( &(fontdata[font].chartbl ) ) + uniCode*sizeof(void *) );
+      width = pgm_read_byte( (uint8_t *)pgm_read_dword( &(fontdata[font].widthtbl ) ) + uniCode );
+      height= pgm_read_byte( &fontdata[font].height );
+    }
+  }
+#endif
+
+  if (!_img || !width) return width * textsize;
+
+  int w = width;
+  byte line = 0;
+
+#ifdef LOAD_FONT2
+  if (font == 2) {
+    w = (w + 6) / 8; // Width in bytes, see TFT_eSPI::drawChar()
+    if (x + width * textsize >= (int32_t)_width) return width * textsize;
+
+    // The TFT version fills whole bytes of background at size 1
+    if (textcolor != textbgcolor)
+      fillRect(x, y, ((textsize == 1) ? w * 8 : width * textsize), height * textsize, textbgcolor);
+
+    for (int i = 0; i < height; i++)
+    {
+      int hpc = 0, px = 0;
+      for (int k = 0; k < w; k++)
+      {
+        line = pgm_read_byte((uint8_t *)flash_address + w * i + k);
+        for (byte mask = 0x80; mask; mask >>= 1, px++)
+        {
+          if (line & mask) hpc++;
+          else if (hpc) {
+            fillRect(x + (px - hpc) * textsize, y + i * textsize, hpc * textsize, textsize, textcolor);
+            hpc = 0;
+          }
+        }
+      }
+      if (hpc) fillRect(x + (px - hpc) * textsize, y + i * textsize, hpc * textsize, textsize, textcolor);
+    }
+  }
+
+  #ifdef LOAD_RLE
+  else
+  #endif
+#endif  //FONT2
+
+#ifdef LOAD_RLE
+  // Font is not 2 and hence is RLE encoded
+  {
+    if (textcolor != textbgcolor) fillRect(x, y, width * textsize, height * textsize, textbgcolor);
+
+    int32_t pc = 0;            // Pixel count
+    int32_t np = width * height;
+
+    // Each foreground run may wrap onto the next character row
+    while (pc < np)
+    {
+      line = pgm_read_byte((uint8_t *)flash_address++);
+      int32_t run = (line & 0x7F) + 1;
+      if (line & 0x80) {
+        while (run) {
+          int32_t px = pc % width, py = pc / width;
+          int32_t n = width - px;
+          if (n > run) n = run;
+          fillRect(x + px * textsize, y + py * textsize, n * textsize, textsize, textcolor);
+          pc += n; run -= n;
+        }
+      }
+      else pc += run;
+    }
+  }
+#endif
+
+  return width * textsize;
+}
+
+
+/***************************************************************************************
+** Class name:              TFT_eDisplayList
+***************************************************************************************/
+// Op codes of the byte coded buffer, all numbers are stored little endian
+#define DL_FILL 1 // x, y, w, h, color: fillRect(), lines are 1 pixel wide rectangles
+#define DL_TEXT 2 // x, y, w, h, color, bgcolor, font, size, glyph_ab, glyph_bb, gfxFont, length, chars
+
+#define DL_FILL_SIZE 11
+#define DL_TEXT_SIZE (18 + sizeof(void*))
+
+/***************************************************************************************
+** Function name:           TFT_eDisplayList
+** Description:             Class constructor, the buffer is allocated by begin()
+***************************************************************************************/
+TFT_eDisplayList::TFT_eDisplayList(TFT_eSPI *tft, uint16_t size)
+{
+  _tft  = tft;
+  _buf  = NULL;
+  _size = size;
+  _len  = 0;
+  _lastFill = -1;
+  _overflow = false;
+}
+
+
+/***************************************************************************************
+** Function name:           ~TFT_eDisplayList
+** Description:             Class destructor, releases the buffer
+***************************************************************************************/
+TFT_eDisplayList::~TFT_eDisplayList(void)
+{
+  if (_buf) free(_buf);
+}
+
+
+/***************************************************************************************
+** Function name:           begin
+** Description:             Clear the list and start recording
+***************************************************************************************/
+boolean TFT_eDisplayList::begin(void)
+{
+  if (!_buf) _buf = (uint8_t*) malloc(_size);
+  _len  = 0;
+  _lastFill = -1;
+  _overflow = (_buf == NULL);
+  return !_overflow;
+}
+
+
+/***************************************************************************************
+** Function name:           fillRect
+** Description:             Record a filled rectangle
+***************************************************************************************/
+// A rectangle of the same colour that continues the previous one to a larger
+// rectangle is merged into it, e.g. the two lines of a 2 pixel wide line
+
+void TFT_eDisplayList::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  if ((w < 1) || (h < 1)) return;
+
+  if (_lastFill >= 0) {
+    uint8_t *p = _buf + _lastFill + 1;
+    int16_t lx = get16(p), ly = get16(p + 2), lw = get16(p + 4), lh = get16(p + 6);
+    if ((uint16_t)get16(p + 8) == (uint16_t)color) {
+      if ((ly == y) && (lh == h) && ((lx + lw == x) || (x + w == lx))) {
+        put16(p, min((int32_t)lx, x));
+        put16(p + 4, lw + w);
+        return;
+      }
+      if ((lx == x) && (lw == w) && ((ly + lh == y) || (y + h == ly))) {
+        put16(p + 2, min((int32_t)ly, y));
+        put16(p + 6, lh + h);
+        return;
+      }
+    }
+  }
+
+  uint8_t *p = reserve(DL_FILL_SIZE);
+  if (!p) return;
+  _lastFill = p - _buf;
+  *p++ = DL_FILL;
+  put16(p, x);
+  put16(p + 2, y);
+  put16(p + 4, w);
+  put16(p + 6, h);
+  put16(p + 8, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawFastHLine, drawFastVLine, drawRect
+** Description:             Record lines, stored as rectangles
+***************************************************************************************/
+void TFT_eDisplayList::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color)
+{
+  fillRect(x, y, w, 1, color);
+}
+
+void TFT_eDisplayList::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color)
+{
+  fillRect(x, y, 1, h, color);
+}
+
+void TFT_eDisplayList::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color)
+{
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+
+/***************************************************************************************
+** Function name:           drawString
+** Description:             Record a string in the font, colours and datum of the TFT
+***************************************************************************************/
+// The datum is resolved here, so replaying needs no textWidth(). Text padding
+// (setTextPadding) is not recorded.
+
+void TFT_eDisplayList::drawString(const char *string, int32_t x, int32_t y)
+{
+  drawString(string, x, y, _tft->textfont);
+}
+
+void TFT_eDisplayList::drawString(const char *string, int32_t x, int32_t y, uint8_t font)
+{
+  uint8_t  len  = min(strlen(string), (size_t)255);
+  uint8_t  size = _tft->textsize;
+  int32_t  w  = _tft->textWidth(string, font);
+  int32_t  h  = 8 * size, // Height of the text box
+           ch = 8,        // Height used for the datum, as in drawString()
+           baseline = 0, top = 0;
+  const void *gfx = NULL;
+
+#ifdef LOAD_GFXFF
+  if ((font == 1) && _tft->gfxFont) {
+    // Free fonts are positioned by the baseline, drawString() moves TL down by glyph_ab
+    gfx = _tft->gfxFont;
+    baseline = ch = top = _tft->glyph_ab * size;
+    h = top + _tft->glyph_bb * size;
+    if ((_tft->textdatum >= BL_DATUM) && (_tft->textdatum <= BR_DATUM)) ch = h;
+    y += top;
+  }
+#endif
+  if (font != 1) {
+    baseline = pgm_read_byte(&fontdata[font].baseline) * size;
+    h = ch = _tft->fontHeight(font);
+  }
+
+  uint8_t datum = _tft->textdatum;
+  if (datum) {
+    // Datums are numbered TL, TC, TR, ML, MC, MR, BL, BC, BR, L, C, R baseline
+    x -= (datum % 3) * w / 2;
+    switch (datum / 3) {
+      case 1: y -= ch / 2; break;
+      case 2: y -= ch; break;
+      case 3: y -= baseline; break;
+    }
+    // Same limits as drawString()
+    if (x < 0) x = 0;
+    if (x + w > (int32_t)_tft->_width) x = _tft->_width - w;
+    if (y < 0) y = 0;
+    if (y + ch - baseline > (int32_t)_tft->_height) y = _tft->_height - ch;
+  }
+  y -= top; // Stored as top left of the text box
+
+  uint8_t *p = reserve(DL_TEXT_SIZE + len);
+  if (!p) return;
+  _lastFill = -1;
+  *p++ = DL_TEXT;
+  put16(p, x);
+  put16(p + 2, y);
+  put16(p + 4, w);
+  put16(p + 6, h);
+  put16(p + 8, _tft->textcolor);
+  put16(p + 10, _tft->textbgcolor);
+  p[12] = font;
+  p[13] = size;
+  p[14] = gfx ? _tft->glyph_ab : 0;
+  p[15] = gfx ? _tft->glyph_bb : 0;
+  memcpy(p + 16, &gfx, sizeof(void*));
+  p[16 + sizeof(void*)] = len;
+  memcpy(p + 17 + sizeof(void*), string, len);
+}
+
+void TFT_eDisplayList::drawString(const String& string, int32_t x, int32_t y)
+{
+  drawString(string.c_str(), x, y);
+}
+
+void TFT_eDisplayList::drawString(const String& string, int32_t x, int32_t y, uint8_t font)
+{
+  drawString(string.c_str(), x, y, font);
+}
+
+
+/***************************************************************************************
+** Function name:           draw
+** Description:             Replay the recorded primitives on the TFT or a sprite
+***************************************************************************************/
+void TFT_eDisplayList::draw(TFT_eSPI *tft)
+{
+  if (!_buf) return;
+
+  // Text settings changed for the replay are restored at the end
+  uint8_t  textfont = tft->textfont, textsize = tft->textsize, textdatum = tft->textdatum;
+  uint32_t textcolor = tft->textcolor, textbgcolor = tft->textbgcolor;
+  int32_t  padX = tft->padX;
+#ifdef LOAD_GFXFF
+  GFXfont *gfxFont = tft->gfxFont;
+  uint8_t  glyph_ab = tft->glyph_ab, glyph_bb = tft->glyph_bb;
+#endif
+
+  tft->textdatum = TL_DATUM;
+  tft->padX = 0;
+
+  uint16_t i = 0;
+  while (i < _len) {
+    uint8_t *p = _buf + i + 1;
+    int16_t  x = get16(p), y = get16(p + 2), w = get16(p + 4), h = get16(p + 6);
+
+    if (_buf[i] == DL_FILL) {
+      uint16_t color = get16(p + 8);
+      if (h == 1)      tft->drawFastHLine(x, y, w, color);
+      else if (w == 1) tft->drawFastVLine(x, y, h, color);
+      else             tft->fillRect(x, y, w, h, color);
+    }
+    else {
+      char str[256];
+      uint8_t len = p[16 + sizeof(void*)];
+      memcpy(str, p + 17 + sizeof(void*), len);
+      str[len] = 0;
+
+      tft->textcolor   = (uint16_t)get16(p + 8);
+      tft->textbgcolor = (uint16_t)get16(p + 10);
+      tft->textsize    = p[13];
+#ifdef LOAD_GFXFF
+      memcpy(&tft->gfxFont, p + 16, sizeof(void*));
+      tft->glyph_ab = p[14];
+      tft->glyph_bb = p[15];
+#endif
+      tft->drawString(str, x, y, p[12]);
+    }
+    i += opSize(i);
+  }
+
+  tft->textfont = textfont;
+  tft->textsize = textsize;
+  tft->textdatum = textdatum;
+  tft->textcolor = textcolor;
+  tft->textbgcolor = textbgcolor;
+  tft->padX = padX;
+#ifdef LOAD_GFXFF
+  tft->gfxFont = gfxFont;
+  tft->glyph_ab = glyph_ab;
+  tft->glyph_bb = glyph_bb;
+#endif
+}
+
+
+/***************************************************************************************
+** Function name:           diff
+** Description:             Find the screen area where two lists draw differently
+***************************************************************************************/
+// The lists are compared op by op, the area covers the changed ops of both lists.
+// After the first op that differs in type or length the rest of both lists counts
+// as changed. Returns false if the lists are equal.
+
+boolean TFT_eDisplayList::diff(TFT_eDisplayList &other, int16_t &x, int16_t &y, int16_t &w, int16_t &h)
+{
+  int32_t x1 = 0x7FFF, y1 = 0x7FFF, x2 = -0x7FFF, y2 = -0x7FFF;
+  uint16_t i = 0, j = 0;
+  boolean  inStep = true; // Ops of both lists still correspond
+
+  while ((i < _len) || (j < other._len)) {
+    uint16_t si = (i < _len) ? opSize(i) : 0;
+    uint16_t sj = (j < other._len) ? other.opSize(j) : 0;
+    if ((si != sj) || (_buf[i] != other._buf[j])) inStep = false;
+
+    if (!inStep || memcmp(_buf + i, other._buf + j, si)) {
+      if (si) opArea(_buf + i, x1, y1, x2, y2);
+      if (sj) opArea(other._buf + j, x1, y1, x2, y2);
+    }
+    i += si;
+    j += sj;
+  }
+
+  if (x2 < x1) return false;
+  x = x1; y = y1; w = x2 - x1; h = y2 - y1;
+  return true;
+}
+
+
+/***************************************************************************************
+** Function name:           swap
+** Description:             Exchange the buffers of two lists of the same TFT
+***************************************************************************************/
+// Lets a new recording be diffed against the last one without copying
+
+void TFT_eDisplayList::swap(TFT_eDisplayList &other)
+{
+  uint8_t *buf = _buf;  _buf  = other._buf;  other._buf  = buf;
+  uint16_t n   = _size; _size = other._size; other._size = n;
+  n = _len;             _len  = other._len;  other._len  = n;
+  int16_t last = _lastFill; _lastFill = other._lastFill; other._lastFill = last;
+  boolean  ovf = _overflow; _overflow = other._overflow; other._overflow = ovf;
+}
+
+
+/***************************************************************************************
+** Function name:           length, overflow
+** Description:             Bytes used, true if the last recording did not fit
+***************************************************************************************/
+uint16_t TFT_eDisplayList::length(void)
+{
+  return _len;
+}
+
+boolean TFT_eDisplayList::overflow(void)
+{
+  return _overflow;
+}
+
+
+/***************************************************************************************
+** Function name:           reserve
+** Description:             Space for the next op, NULL and overflow set if full
+***************************************************************************************/
+uint8_t* TFT_eDisplayList::reserve(uint16_t bytes)
+{
+  if (!_buf || (_len + bytes > _size)) {
+    _overflow = true;
+    return NULL;
+  }
+  uint8_t *p = _buf + _len;
+  _len += bytes;
+  return p;
+}
+
+
+/***************************************************************************************
+** Function name:           opSize, opArea
+** Description:             Size in bytes and screen area of the op at an offset
+***************************************************************************************/
+uint16_t TFT_eDisplayList::opSize(uint16_t i)
+{
+  if (_buf[i] == DL_FILL) return DL_FILL_SIZE;
+  return DL_TEXT_SIZE + _buf[i + 17 + sizeof(void*)];
+}
+
+void TFT_eDisplayList::opArea(const uint8_t *op, int32_t &x1, int32_t &y1, int32_t &x2, int32_t &y2)
+{
+  int16_t x = get16(op + 1), y = get16(op + 3), w = get16(op + 5), h = get16(op + 7);
+  if (x < x1) x1 = x;
+  if (y < y1) y1 = y;
+  if (x + w > x2) x2 = x + w;
+  if (y + h > y2) y2 = y + h;
+}
+
+
+/***************************************************************************************
+** Function name:           put16, get16
+** Description:             Little endian 16 bit numbers in the buffer
+***************************************************************************************/
+void TFT_eDisplayList::put16(uint8_t *p, int32_t v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+}
+
+int16_t TFT_eDisplayList::get16(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+
 /***************************************************
   The majority of code in this file is "FunWare", the only condition of use of
   those portions is that users have fun!  Most of the effort has been spent on
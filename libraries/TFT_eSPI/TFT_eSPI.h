@@ -236,6 +236,11 @@
 template <typename T> static inline void
 swap_coord(T& a, T& b) { T t = a; a = b; b = t; }
 
+// Integer sine and cosine, a turn is 256 steps and 0x7FFF stands for 1.0
+int16_t sinQ15(uint8_t angle);
+int16_t cosQ15(uint8_t angle);
+int32_t mulQ15(int32_t r, int16_t q15);  // r * q15, rounded to the nearest integer
+
 // This is a structure to conveniently hold infomation on the default fonts
 // Stores pointer to font character image address table, width table and height
 
@@ -295,16 +300,29 @@ const PROGMEM fontinfo fontdata [] = {
 // Class functions and variables
 class TFT_eSPI : public Print {
 
+  friend class TFT_eDisplayList;
+
  public:
 
   TFT_eSPI(int16_t _W = TFT_WIDTH, int16_t _H = TFT_HEIGHT);
 
   void     init(void), begin(void); // Same - begin included for backwards compatibility
 
-  void     drawPixel(uint32_t x, uint32_t y, uint32_t color);
+  // These are virtual so the TFT_eSprite class can override them with sprite specific functions
+  virtual void drawPixel(uint32_t x, uint32_t y, uint32_t color),
+               drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, uint32_t bg, uint8_t font),
+               drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color),
+               drawThickLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color),
+               drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color),
+               drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
+               fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+               drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor),
+               drawRLE(int32_t x, int32_t y, const uint8_t *rle, int32_t w, int32_t h, uint32_t fgcolor, uint32_t bgcolor);
 
-  void     drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, uint32_t bg, uint8_t font),
-           setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1),
+  virtual int16_t drawChar(unsigned int uniCode, int x, int y, int font),
+                  drawChar(unsigned int uniCode, int x, int y);
+
+  void     setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1),
 
            pushColor(uint16_t color),
            pushColor(uint16_t color, uint16_t len),
@@ -314,12 +332,13 @@ class TFT_eSPI : public Print {
 
            fillScreen(uint32_t color),
 
-           drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color),
-           drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color),
-           drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
-
            drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
-           fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+
+           // Charts of n samples, sample i is at x + i * dx, the baseline row is not filled
+           drawPolyline(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t thickness, uint32_t color),
+           fillAreaUnderCurve(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t baseline, uint32_t color),
+           drawBars(int32_t x, int32_t dx, const int16_t *y, uint16_t n, int32_t w, int32_t baseline, uint32_t color),
+
            drawRoundRect(int32_t x0, int32_t y0, int32_t w, int32_t h, int32_t radius, uint32_t color),
            fillRoundRect(int32_t x0, int32_t y0, int32_t w, int32_t h, int32_t radius, uint32_t color),
 
@@ -381,12 +400,14 @@ class TFT_eSPI : public Print {
 
   uint8_t  getRotation(void);
 
+           // Count of bytes sent to the TFT, needs TFT_SPI_STATS defined in User_Setup.h
+  uint32_t spiBytes(void);
+  void     resetSpiBytes(void);
+
   uint16_t fontsLoaded(void),
            color565(uint8_t r, uint8_t g, uint8_t b);
 
-  int16_t  drawChar(unsigned int uniCode, int x, int y, int font),
-           drawChar(unsigned int uniCode, int x, int y),
-           drawNumber(long long_num,int poX, int poY, int font),
+  int16_t  drawNumber(long long_num,int poX, int poY, int font),
            drawNumber(long long_num,int poX, int poY),
            drawFloat(float floatNumber,int decimal,int poX, int poY, int font),
            drawFloat(float floatNumber,int decimal,int poX, int poY),
@@ -433,6 +454,10 @@ inline void spi_end() __attribute__((always_inline));
 
  protected:
 
+           // Bresenham line as thickness wide runs, each run and chart part is one clipped fillRect()
+  void     drawLineRuns(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color),
+           fillLineRun(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+
   int32_t  cursor_x, cursor_y, win_xe, win_ye, padX;
 
   uint32_t _width, _height; // Display w/h as modified by current rotation
@@ -454,6 +479,144 @@ inline void spi_end() __attribute__((always_inline));
     *gfxFont;
 #endif
 
+#if defined (LOAD_GFXFF) && defined (GLYPH_CACHE)
+           // Draw a glyph from the RAM glyph cache as runs, transparent like uncached FreeFont glyphs
+  void     drawGlyphBits(int32_t x, int32_t y, const uint8_t *bits, uint8_t w, uint8_t h, uint32_t color);
+#endif
+
+};
+
+
+/***************************************************************************************
+** Class name:              TFT_eSprite
+** Description:             RAM canvas using the TFT_eSPI drawing functions
+***************************************************************************************/
+// Everything is rendered into a 16 bit RGB565 buffer held in RAM and sent to the TFT
+// with a single setAddrWindow() + burst write when pushSprite() is called.
+// A canvas too large for the available RAM can be created in "banded" mode: only a
+// strip of bandHeight rows is allocated and the same drawing code is run once per
+// band, selected with selectBand(), pushing each band to the screen in turn.
+
+class TFT_eSprite : public TFT_eSPI {
+
+ public:
+
+  TFT_eSprite(TFT_eSPI *tft);
+  ~TFT_eSprite(void);
+
+           // Create a w x h canvas, returns a pointer to the buffer or NULL if out of RAM
+  void*    createSprite(int16_t w, int16_t h, int16_t bandHeight = 0);
+           // Create a buffer covering an area of the TFT, drawing then uses TFT coordinates
+  void*    createWindow(int32_t x, int32_t y, int16_t w, int16_t h, int16_t bandHeight = 0);
+  void     deleteSprite(void);
+  boolean  created(void);
+
+           // Banded mode, bands() is 1 for a sprite with a full buffer
+  uint8_t  bands(void);
+  void     selectBand(uint8_t band);
+
+  void     fillSprite(uint32_t color),
+           pushSprite(int32_t x, int32_t y),
+           pushSprite(void); // Push to the createWindow() position
+
+           // Write the current buffer as a binary PPM (P6) image, e.g. to Serial or a file
+  void     writePPM(Print &out);
+
+  uint16_t readPixel(int32_t x, int32_t y);
+  uint16_t *getPointer(void);
+
+  void     drawPixel(uint32_t x, uint32_t y, uint32_t color),
+           drawChar(int32_t x, int32_t y, unsigned char c, uint32_t color, uint32_t bg, uint8_t size),
+           drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color),
+           drawThickLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t thickness, uint32_t color),
+           drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color),
+           drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
+           fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+           drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t fgcolor, uint16_t bgcolor),
+           drawRLE(int32_t x, int32_t y, const uint8_t *rle, int32_t w, int32_t h, uint32_t fgcolor, uint32_t bgcolor),
+
+           setWindow(int16_t x0, int16_t y0, int16_t x1, int16_t y1),
+           pushColor(uint16_t color),
+           pushColor(uint16_t color, uint16_t len),
+           pushColors(uint16_t *data, uint8_t len);
+
+  int16_t  drawChar(unsigned int uniCode, int x, int y, int font),
+           drawChar(unsigned int uniCode, int x, int y);
+
+           // The transparent drawBitmap() of TFT_eSPI draws runs and works unchanged
+  using    TFT_eSPI::drawBitmap;
+
+ private:
+
+  TFT_eSPI *_tft;
+
+  uint16_t *_img;             // Pixel buffer, colours are stored byte swapped ready for the SPI bus
+
+  int32_t  _iwidth, _iheight, // Buffer size in pixels
+           _xorg, _yorg,      // Canvas position of the area covered by the buffer
+           _harea,            // Height of that area, more than _iheight in banded mode
+           _yband,            // Canvas row held in the first buffer row
+           _xs, _ys, _xe, _ye,// setWindow() area
+           _xptr, _yptr;      // pushColor() write position
+
+};
+
+
+/***************************************************************************************
+** Class name:              TFT_eDisplayList
+** Description:             Records drawing operations to replay them later
+***************************************************************************************/
+// Fills, lines and strings are stored in a compact byte coded buffer with the text
+// datum already resolved, so replaying them needs no text measuring or number
+// formatting. Adjacent rectangles of one colour are merged while recording. Two
+// recordings can be compared with diff() to redraw only the area that changed.
+
+class TFT_eDisplayList {
+
+ public:
+
+  TFT_eDisplayList(TFT_eSPI *tft, uint16_t size);
+  ~TFT_eDisplayList(void);
+
+           // Clear the list and start a new recording, false if out of RAM
+  boolean  begin(void);
+
+  void     fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+           drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color),
+           drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color),
+           drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color),
+
+           // Strings use the text colours, size, datum and free font set on the TFT
+           drawString(const char *string, int32_t x, int32_t y),
+           drawString(const char *string, int32_t x, int32_t y, uint8_t font),
+           drawString(const String& string, int32_t x, int32_t y),
+           drawString(const String& string, int32_t x, int32_t y, uint8_t font);
+
+           // Replay on the TFT or a sprite
+  void     draw(TFT_eSPI *tft);
+
+           // Area drawn differently by the two lists, false if they are equal
+  boolean  diff(TFT_eDisplayList &other, int16_t &x, int16_t &y, int16_t &w, int16_t &h);
+  void     swap(TFT_eDisplayList &other);
+
+  uint16_t length(void);
+  boolean  overflow(void);
+
+ private:
+
+  uint8_t* reserve(uint16_t bytes);
+  uint16_t opSize(uint16_t i);
+  void     opArea(const uint8_t *op, int32_t &x1, int32_t &y1, int32_t &x2, int32_t &y2);
+  void     put16(uint8_t *p, int32_t v);
+  int16_t  get16(const uint8_t *p);
+
+  TFT_eSPI *_tft;     // Measures the strings while recording
+
+  uint8_t  *_buf;
+  uint16_t _size, _len;
+  int16_t  _lastFill; // Offset of the last op if it is a fill, for merging
+  boolean  _overflow;
+
 };
 
 #endif
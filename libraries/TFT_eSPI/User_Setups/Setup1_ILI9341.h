@@ -150,3 +150,15 @@
 // Transaction support is needed to work with SD library but not needed with TFT_SdFat
 
 // #define SUPPORT_TRANSACTIONS
+
+// Uncomment the following #define to count the bytes sent to the TFT, the count is
+// read with tft.spiBytes(). Useful to compare how much SPI traffic a screen update needs.
+
+// #define TFT_SPI_STATS
+
+// Uncomment to keep the given number of FreeFont glyphs unpacked in RAM. It saves decoding
+// the FLASH bit stream, glyphs are still drawn run by run, so the SPI traffic is the same.
+// Each entry takes about 100 bytes, glyphs larger than GLYPH_CACHE_BYTES are never cached.
+
+// #define GLYPH_CACHE 16
+// #define GLYPH_CACHE_BYTES 96
@@ -0,0 +1,389 @@
+/**
+  ILI9341 display model
+  Name: ILI9341Sim.cpp
+  Purpose: Receives the SPI traffic of TFT_eSPI on the host, keeps the display
+           memory and counts what was sent
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <TFT_eSPI.h>
+#include "ILI9341Sim.h"
+
+ILI9341Sim tftSim;
+
+/**
+  All SPI traffic of the host core ends here. The levels of TFT_CS and TFT_DC
+  decide if and how the display takes the byte.
+*/
+uint8_t hostSpiTransfer(uint8_t out)
+{
+#ifdef TFT_CS
+  if (GPO & digitalPinToBitMask(TFT_CS)) return 0xFF;
+#endif
+  return tftSim.transfer(out, GPO & digitalPinToBitMask(TFT_DC));
+}
+
+ILI9341Sim::ILI9341Sim()
+{
+  reset();
+  fill(0);
+  resetStats();
+}
+
+/**
+  State after a hardware or software reset, the memory keeps its content.
+*/
+void ILI9341Sim::reset()
+{
+  _madctl = 0;
+  _cmd = TFT_NOP;
+  _nParam = 0;
+  _xs = 0;  _xe = SIM_TFT_WIDTH - 1;
+  _ys = 0;  _ye = SIM_TFT_HEIGHT - 1;
+  _col = 0; _page = 0;
+  _odd = false;
+  _moved = false;
+  _rd = 0;
+}
+
+uint8_t ILI9341Sim::transfer(uint8_t out, bool dc)
+{
+  if (!dc)
+  {
+    _stats.commands++;
+    command(out);
+    return 0xFF;
+  }
+
+  _stats.dataBytes++;
+  if (_cmd == TFT_RAMRD) return readByte();
+  data(out);
+  return 0xFF;
+}
+
+const ILI9341Sim::Stats &ILI9341Sim::stats()
+{
+  return _stats;
+}
+
+void ILI9341Sim::resetStats()
+{
+  memset(&_stats, 0, sizeof(_stats));
+}
+
+/**
+  Time the bytes counted take on the bus at the given SPI clock.
+*/
+uint32_t ILI9341Sim::busMicros(uint32_t frequency)
+{
+  uint64_t bits = 8ULL * (_stats.commands + _stats.dataBytes);
+  return (bits * 1000000ULL + frequency / 2) / frequency;
+}
+
+int16_t ILI9341Sim::width()
+{
+  return (_madctl & TFT_MAD_MV) ? SIM_TFT_HEIGHT : SIM_TFT_WIDTH;
+}
+
+int16_t ILI9341Sim::height()
+{
+  return (_madctl & TFT_MAD_MV) ? SIM_TFT_WIDTH : SIM_TFT_HEIGHT;
+}
+
+/**
+  Colour at x, y in the current rotation.
+*/
+uint16_t ILI9341Sim::pixel(int16_t x, int16_t y)
+{
+  if ((x < 0) || (y < 0) || (x >= width()) || (y >= height())) return 0;
+  return _gram[address(x, y)];
+}
+
+void ILI9341Sim::fill(uint16_t color)
+{
+  for (uint32_t i = 0; i < SIM_TFT_WIDTH * SIM_TFT_HEIGHT; i++) _gram[i] = color;
+}
+
+
+// Commands
+
+void ILI9341Sim::command(uint8_t cmd)
+{
+  _cmd = cmd;
+  _nParam = 0;
+  _odd = false;
+
+  switch (cmd)
+  {
+    case TFT_SWRST:
+      reset();
+      break;
+    case TFT_RAMWR:
+    case TFT_RAMRD:
+      if (_moved) _stats.windows++;
+      _moved = false;
+      _col = _xs;
+      _page = _ys;
+      _rd = 0;
+      break;
+  }
+}
+
+void ILI9341Sim::data(uint8_t b)
+{
+  if (_cmd == TFT_RAMWR)
+  {
+    if (_odd) writePixel((_hi << 8) | b);
+    else _hi = b;
+    _odd = !_odd;
+    return;
+  }
+
+  if (_nParam < sizeof(_param)) _param[_nParam] = b;
+  _nParam++;
+
+  switch (_cmd)
+  {
+    case TFT_MADCTL:
+      if (_nParam == 1) _madctl = b;
+      break;
+    case TFT_CASET:
+      if (_nParam == 4)
+      {
+        _xs = (_param[0] << 8) | _param[1];
+        _xe = (_param[2] << 8) | _param[3];
+        _moved = true;
+      }
+      break;
+    case TFT_PASET:
+      if (_nParam == 4)
+      {
+        _ys = (_param[0] << 8) | _param[1];
+        _ye = (_param[2] << 8) | _param[3];
+        _moved = true;
+      }
+      break;
+  }
+}
+
+void ILI9341Sim::writePixel(uint16_t color)
+{
+  _stats.pixels++;
+  if ((_col < width()) && (_page < height())) _gram[address(_col, _page)] = color;
+  nextAddress();
+}
+
+/**
+  RAMRD sends a dummy byte first, then 6 bit red, green and blue in the upper
+  bits of one byte each.
+*/
+uint8_t ILI9341Sim::readByte()
+{
+  uint8_t b = 0;
+  if (_rd == 0)
+  {
+    _rd = 1;
+    return 0;
+  }
+
+  if (_rd == 1) _rdColor = ((_col < width()) && (_page < height())) ? _gram[address(_col, _page)] : 0;
+  switch (_rd)
+  {
+    case 1: b = (_rdColor >> 8) & 0xF8;  break;
+    case 2: b = (_rdColor >> 3) & 0xFC;  break;
+    case 3: b = (_rdColor << 3) & 0xF8;  break;
+  }
+  if (++_rd > 3)
+  {
+    _rd = 1;
+    nextAddress();
+  }
+  return b;
+}
+
+/**
+  Index in the memory of column col and page page. MADCTL exchanges (MV) and
+  mirrors (MX, MY) the addresses, rotation 0 (MX only) is the portrait view
+  the memory is kept in.
+*/
+uint32_t ILI9341Sim::address(uint16_t col, uint16_t page)
+{
+  uint16_t a = (_madctl & TFT_MAD_MV) ? page : col;
+  uint16_t b = (_madctl & TFT_MAD_MV) ? col : page;
+  if (_madctl & TFT_MAD_MX) a = SIM_TFT_WIDTH - 1 - a;
+  if (_madctl & TFT_MAD_MY) b = SIM_TFT_HEIGHT - 1 - b;
+  return (uint32_t)b * SIM_TFT_WIDTH + (SIM_TFT_WIDTH - 1 - a);
+}
+
+// The pointer runs through the window row by row and starts over at its end
+void ILI9341Sim::nextAddress()
+{
+  if (++_col <= _xe) return;
+  _col = _xs;
+  if (++_page > _ye) _page = _ys;
+}
+
+
+// PNG images, 8 bit RGB in stored deflate blocks. The output only depends on
+// the pixels, so equal images give equal files.
+
+static uint32_t crc32(uint32_t crc, const uint8_t *buf, size_t len)
+{
+  static uint32_t table[256];
+  if (!table[1])
+  {
+    for (uint32_t n = 0; n < 256; n++)
+    {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      table[n] = c;
+    }
+  }
+  crc = ~crc;
+  while (len--) crc = table[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+static void put32(std::vector<uint8_t> &out, uint32_t v)
+{
+  out.push_back(v >> 24);  out.push_back(v >> 16);
+  out.push_back(v >> 8);   out.push_back(v);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void putChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+  put32(out, data.size());
+  size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  put32(out, crc32(0, &out[start], out.size() - start));
+}
+
+bool ILI9341Sim::writePNG(const char *file)
+{
+  int16_t w = width();
+  int16_t h = height();
+
+  // Rows with filter type 0 in front
+  std::vector<uint8_t> raw;
+  for (int16_t y = 0; y < h; y++)
+  {
+    raw.push_back(0);
+    for (int16_t x = 0; x < w; x++)
+    {
+      uint16_t c = pixel(x, y);
+      raw.push_back(((c >> 8) & 0xF8) | (c >> 13));
+      raw.push_back(((c >> 3) & 0xFC) | ((c >> 9) & 0x03));
+      raw.push_back(((c << 3) & 0xF8) | ((c >> 2) & 0x07));
+    }
+  }
+
+  std::vector<uint8_t> z;
+  z.push_back(0x78);
+  z.push_back(0x01);
+  for (size_t pos = 0; pos < raw.size(); pos += 0xFFFF)
+  {
+    uint16_t len = (raw.size() - pos > 0xFFFF) ? 0xFFFF : raw.size() - pos;
+    z.push_back((pos + len == raw.size()) ? 1 : 0);
+    z.push_back(len);   z.push_back(len >> 8);
+    z.push_back(~len);  z.push_back(~len >> 8);
+    z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+  }
+  uint32_t s1 = 1, s2 = 0;
+  for (size_t i = 0; i < raw.size(); i++)
+  {
+    s1 = (s1 + raw[i]) % 65521;
+    s2 = (s2 + s1) % 65521;
+  }
+  put32(z, (s2 << 16) | s1);
+
+  std::vector<uint8_t> ihdr;
+  put32(ihdr, w);
+  put32(ihdr, h);
+  const uint8_t format[] = {8, 2, 0, 0, 0};   // 8 bit RGB, no interlace
+  ihdr.insert(ihdr.end(), format, format + sizeof(format));
+
+  const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  std::vector<uint8_t> png(signature, signature + sizeof(signature));
+  putChunk(png, "IHDR", ihdr);
+  putChunk(png, "IDAT", z);
+  putChunk(png, "IEND", std::vector<uint8_t>());
+
+  FILE *f = fopen(file, "wb");
+  if (!f) return false;
+  bool ok = (fwrite(png.data(), 1, png.size(), f) == png.size());
+  return (fclose(f) == 0) && ok;
+}
+
+/**
+  Number of pixels that differ from an image written by writePNG(), -1 if the
+  file can't be read or has another size or format.
+*/
+int32_t ILI9341Sim::comparePNG(const char *file)
+{
+  FILE *f = fopen(file, "rb");
+  if (!f) return -1;
+  std::vector<uint8_t> png;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) png.insert(png.end(), buf, buf + n);
+  fclose(f);
+
+  // Chunks
+  int16_t w = width();
+  int16_t h = height();
+  std::vector<uint8_t> z;
+  bool header = false;
+  for (size_t pos = 8; pos + 12 <= png.size(); )
+  {
+    uint32_t len = get32(&png[pos]);
+    if (pos + 12 + len > png.size()) return -1;
+    const uint8_t *data = &png[pos + 8];
+    if (memcmp(&png[pos + 4], "IHDR", 4) == 0)
+    {
+      if ((len < 13) || (get32(data) != (uint32_t)w) || (get32(data + 4) != (uint32_t)h)) return -1;
+      if ((data[8] != 8) || (data[9] != 2) || (data[12] != 0)) return -1;
+      header = true;
+    }
+    if (memcmp(&png[pos + 4], "IDAT", 4) == 0) z.insert(z.end(), data, data + len);
+    pos += 12 + len;
+  }
+  if (!header || (z.size() < 2)) return -1;
+
+  // Stored deflate blocks only
+  std::vector<uint8_t> raw;
+  size_t pos = 2;
+  bool last = false;
+  while (!last)
+  {
+    if (pos + 5 > z.size() || (z[pos] & 0x06)) return -1;
+    last = z[pos] & 1;
+    uint16_t len = z[pos + 1] | (z[pos + 2] << 8);
+    pos += 5;
+    if (pos + len > z.size()) return -1;
+    raw.insert(raw.end(), z.begin() + pos, z.begin() + pos + len);
+    pos += len;
+  }
+  if (raw.size() != (size_t)h * (1 + 3 * w)) return -1;
+
+  int32_t differ = 0;
+  for (int16_t y = 0; y < h; y++)
+  {
+    const uint8_t *row = &raw[y * (1 + 3 * w)];
+    if (row[0] != 0) return -1;
+    for (int16_t x = 0; x < w; x++)
+    {
+      const uint8_t *p = row + 1 + 3 * x;
+      uint16_t c = ((p[0] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[2] >> 3);
+      if (c != pixel(x, y)) differ++;
+    }
+  }
+  return differ;
+}
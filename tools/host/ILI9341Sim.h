@@ -0,0 +1,74 @@
+/**
+  ILI9341 display model Header
+  Name: ILI9341Sim.h
+  Purpose: Receives the SPI traffic of TFT_eSPI on the host, keeps the display
+           memory and counts what was sent
+
+  The pins are TFT_DC and TFT_CS of the TFT_eSPI setup, bytes sent while
+  TFT_CS is high belong to other devices on the bus and are ignored.
+  The memory is kept in the portrait view of rotation 0, pixel() and the
+  images show it in the orientation set by the last MADCTL.
+*/
+
+#ifndef ILI9341Sim_h
+#define ILI9341Sim_h
+
+#include <stdint.h>
+
+#define SIM_TFT_WIDTH  240
+#define SIM_TFT_HEIGHT 320
+
+class ILI9341Sim
+{
+  public:
+    // Traffic since the last resetStats()
+    typedef struct Stats
+    {
+      uint32_t commands;          // Command bytes (DC low)
+      uint32_t dataBytes;         // Parameter and pixel bytes (DC high)
+      uint32_t windows;           // Address windows set with CASET/PASET and used
+      uint32_t pixels;            // Pixels written with RAMWR
+    } Stats;
+
+    ILI9341Sim();
+    void reset();
+    uint8_t transfer(uint8_t out, bool dc);
+
+    const Stats &stats();
+    void resetStats();
+    uint32_t busMicros(uint32_t frequency);
+
+    int16_t width();
+    int16_t height();
+    uint16_t pixel(int16_t x, int16_t y);
+    void fill(uint16_t color);
+
+    bool writePNG(const char *file);
+    int32_t comparePNG(const char *file);
+
+  private:
+    void command(uint8_t cmd);
+    void data(uint8_t b);
+    void writePixel(uint16_t color);
+    uint8_t readByte();
+    uint32_t address(uint16_t col, uint16_t page);
+    void nextAddress();
+
+    uint16_t _gram[SIM_TFT_WIDTH * SIM_TFT_HEIGHT];
+    uint8_t _madctl;
+    uint8_t _cmd;
+    uint8_t _param[4];
+    uint8_t _nParam;
+    uint16_t _xs, _xe, _ys, _ye;  // Address window
+    uint16_t _col, _page;         // Memory pointer inside the window
+    uint8_t _hi;                  // First byte of a pixel
+    bool _odd;                    // One byte of a pixel received
+    bool _moved;                  // Window changed since the last RAMWR/RAMRD
+    uint8_t _rd;                  // RAMRD: 0 before the dummy byte, then 1..3 for R, G, B
+    uint16_t _rdColor;
+    Stats _stats;
+};
+
+extern ILI9341Sim tftSim;
+
+#endif
@@ -0,0 +1,167 @@
+/**
+  Host Arduino core
+  Name: Arduino.h
+  Purpose: The part of the ESP8266 Arduino core used by the display code, for
+           building TFT_eSPI and Display.cpp on Linux (see tools/host/tftbench.cpp)
+
+  Time only moves with delay(), so a run gives the same result every time.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#ifndef ARDUINO
+#define ARDUINO 10805
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x00
+#define OUTPUT       0x01
+#define INPUT_PULLUP 0x02
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bit(b) (1UL << (b))
+
+#define ICACHE_RAM_ATTR
+#define ICACHE_FLASH_ATTR
+
+// NodeMCU pin names
+#define PIN_D0 16
+#define PIN_D1 5
+#define PIN_D2 4
+#define PIN_D3 0
+#define PIN_D4 2
+#define PIN_D5 14
+#define PIN_D6 12
+#define PIN_D7 13
+#define PIN_D8 15
+static const uint8_t D0 = PIN_D0;
+static const uint8_t D1 = PIN_D1;
+static const uint8_t D2 = PIN_D2;
+static const uint8_t D3 = PIN_D3;
+static const uint8_t D4 = PIN_D4;
+static const uint8_t D5 = PIN_D5;
+static const uint8_t D6 = PIN_D6;
+static const uint8_t D7 = PIN_D7;
+static const uint8_t D8 = PIN_D8;
+
+#define digitalPinToBitMask(pin) (1UL << (pin))
+#define digitalPinToInterrupt(pin) (pin)
+
+#include "pgmspace.h"
+#include "esp8266_peri.h"
+#include "WString.h"
+#include "Print.h"
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+// stdlib_noniso of the ESP8266 core
+char *itoa(int value, char *result, int base);
+char *ltoa(long value, char *result, int base);
+char *utoa(unsigned value, char *result, int base);
+char *ultoa(unsigned long value, char *result, int base);
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+class Stream : public Print
+{
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+    String readStringUntil(char terminator);
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+  protected:
+    unsigned long _timeout = 1000;
+};
+
+// Goes to stderr, stdout is left to the host program
+class HardwareSerial : public Stream
+{
+  public:
+    void begin(unsigned long baud) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    size_t write(uint8_t c) { return fputc(c, stderr) == EOF ? 0 : 1; }
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+class EspClass
+{
+  public:
+    uint32_t getFreeHeap() { return 81920; }
+    uint32_t getCpuFreqMHz() { return 80; }
+    void deepSleep(uint64_t time_us) {}
+    void restart() {}
+};
+
+extern EspClass ESP;
+
+#endif
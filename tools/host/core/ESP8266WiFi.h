@@ -0,0 +1,79 @@
+/**
+  Host Arduino core
+  Name: ESP8266WiFi.h
+  Purpose: WiFi without a network, clients read recorded responses
+
+  hostReplay() gives a client connecting to host the bytes of a file, e.g. a
+  response recorded with "curl --http1.0 -si URL > file". Clients connecting to
+  other hosts fail. The station counts as connected once a recording is set.
+*/
+
+#ifndef ESP8266WiFi_h
+#define ESP8266WiFi_h
+
+#include "Arduino.h"
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+class IPAddress
+{
+  public:
+    IPAddress() : _address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t address) : _address(address) {}
+    operator uint32_t() const { return _address; }
+    uint8_t operator[](int index) const { return (_address >> (8 * index)) & 0xFF; }
+    String toString() const { return String((*this)[0]) + "." + String((*this)[1]) + "." + String((*this)[2]) + "." + String((*this)[3]); }
+
+  private:
+    uint32_t _address;
+};
+
+bool hostReplay(const char *host, const char *file);
+void hostReplayClear();
+extern uint32_t hostReplayBytes;  // Bytes read by all clients
+
+class WiFiClient : public Stream
+{
+  public:
+    virtual ~WiFiClient() {}
+    virtual int connect(const char *host, uint16_t port);
+    virtual int connect(IPAddress ip, uint16_t port) { return 0; }
+    virtual uint8_t connected() { return _rxPos < _rxLen; }
+    virtual void stop() { _rxLen = _rxPos = 0; }
+    int available() { return _rxLen - _rxPos; }
+    int read();
+    int read(uint8_t *buf, size_t size);
+    int peek() { return connected() ? _rx[_rxPos] : -1; }
+    size_t write(uint8_t c) { return 1; }
+    size_t write(const uint8_t *buf, size_t size) { return size; }
+    using Print::write;
+    void setNoDelay(bool nodelay) {}
+    operator bool() { return connected(); }
+
+  private:
+    const uint8_t *_rx = NULL;    // Recording being read
+    size_t _rxLen = 0;
+    size_t _rxPos = 0;
+};
+
+class ESP8266WiFiClass
+{
+  public:
+    wl_status_t begin(const char *ssid, const char *passphrase = NULL) { return status(); }
+    wl_status_t status();
+    bool disconnect(bool wifioff = false) { return true; }
+    IPAddress localIP() { return IPAddress(); }
+    int hostByName(const char *host, IPAddress &result) { return 0; }
+};
+
+extern ESP8266WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,54 @@
+/**
+  Host Arduino core
+  Name: FS.h
+  Purpose: SPIFFS kept in a directory of the host, every file of the flash
+           file system is a file there
+*/
+
+#ifndef FS_h
+#define FS_h
+
+#include "Arduino.h"
+
+// Directory holding the files, set before SPIFFS.begin()
+extern const char *hostFsRoot;
+
+namespace fs {
+
+class File : public Stream
+{
+  public:
+    File(FILE *f = NULL) : _f(f) {}
+    operator bool() const { return _f != NULL; }
+    int available();
+    int read();
+    size_t read(uint8_t *buf, size_t size);
+    int peek();
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    using Print::write;
+    size_t size();
+    void close();
+
+  private:
+    FILE *_f;
+};
+
+class FS
+{
+  public:
+    bool begin();
+    File open(const char *path, const char *mode);
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *pathFrom, const char *pathTo);
+};
+
+}
+
+using fs::File;
+using fs::FS;
+
+extern fs::FS SPIFFS;
+
+#endif
@@ -0,0 +1,53 @@
+/**
+  Host Arduino core
+  Name: SPI.h
+  Purpose: ESP8266 SPI class, every byte goes to hostSpiTransfer()
+*/
+
+#ifndef SPI_h
+#define SPI_h
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x10
+#define SPI_MODE3 0x11
+
+class SPISettings
+{
+  public:
+    SPISettings() : _clock(1000000) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : _clock(clock) {}
+    uint32_t _clock;
+};
+
+class SPIClass
+{
+  public:
+    void begin();
+    void end() {}
+    void setHwCs(bool use) {}
+    void setBitOrder(uint8_t bitOrder) {}
+    void setDataMode(uint8_t dataMode) {}
+    void setFrequency(uint32_t freq) { hostSpiFrequency = freq; }
+    void setClockDivider(uint32_t clockDiv) {}
+    void beginTransaction(SPISettings settings) { setFrequency(settings._clock); }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data) { return hostSpiTransfer(data); }
+    uint16_t transfer16(uint16_t data);
+    void transferBytes(const uint8_t *out, uint8_t *in, uint32_t size);
+    void write(uint8_t data) { hostSpiTransfer(data); }
+    void write16(uint16_t data);
+    void write16(uint16_t data, bool msb);
+    void write32(uint32_t data);
+    void write32(uint32_t data, bool msb);
+    void writeBytes(const uint8_t *data, uint32_t size);
+    void writePattern(const uint8_t *data, uint8_t size, uint32_t repeat);
+};
+
+extern SPIClass SPI;
+
+#endif
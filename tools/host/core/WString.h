@@ -0,0 +1,129 @@
+/**
+  Host Arduino core
+  Name: WString.h
+  Purpose: Arduino String on top of std::string
+*/
+
+#ifndef WString_h
+#define WString_h
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+
+class String
+{
+  public:
+    String(const char *cstr = "") : _s(cstr ? cstr : "") {}
+    String(const std::string &s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10) : _s(fromInt(value, base)) {}
+    explicit String(int value, unsigned char base = 10) : _s(fromInt(value, base)) {}
+    explicit String(unsigned int value, unsigned char base = 10) : _s(fromInt(value, base)) {}
+    explicit String(long value, unsigned char base = 10) : _s(fromInt(value, base)) {}
+    explicit String(unsigned long value, unsigned char base = 10) : _s(fromInt(value, base)) {}
+    explicit String(float value, unsigned char decimals = 2) : _s(fromFloat(value, decimals)) {}
+    explicit String(double value, unsigned char decimals = 2) : _s(fromFloat(value, decimals)) {}
+
+    unsigned int length() const { return _s.length(); }
+    const char *c_str() const { return _s.c_str(); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+
+    String &operator+=(const String &rhs) { _s += rhs._s; return *this; }
+    String &operator+=(const char *cstr) { _s += cstr; return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    String &operator+=(int value) { return *this += String(value); }
+    String &operator+=(unsigned int value) { return *this += String(value); }
+    String &operator+=(long value) { return *this += String(value); }
+    String &operator+=(unsigned long value) { return *this += String(value); }
+    bool concat(const String &s) { _s += s._s; return true; }
+    bool concat(const char *cstr) { _s += cstr; return true; }
+    bool concat(char c) { _s += c; return true; }
+
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs._s + rhs._s); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs._s + rhs); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(lhs + rhs._s); }
+    friend String operator+(const String &lhs, char rhs) { return String(lhs._s + rhs); }
+
+    bool equals(const String &s) const { return _s == s._s; }
+    bool operator==(const String &rhs) const { return _s == rhs._s; }
+    bool operator==(const char *cstr) const { return _s == cstr; }
+    bool operator!=(const String &rhs) const { return _s != rhs._s; }
+    bool operator!=(const char *cstr) const { return _s != cstr; }
+    bool operator<(const String &rhs) const { return _s < rhs._s; }
+    int compareTo(const String &s) const { return _s.compare(s._s); }
+    bool startsWith(const String &prefix) const { return _s.compare(0, prefix._s.length(), prefix._s) == 0; }
+    bool endsWith(const String &suffix) const
+    {
+      return (_s.length() >= suffix._s.length()) && (_s.compare(_s.length() - suffix._s.length(), std::string::npos, suffix._s) == 0);
+    }
+
+    char charAt(unsigned int index) const { return (index < _s.length()) ? _s[index] : 0; }
+    void setCharAt(unsigned int index, char c) { if (index < _s.length()) _s[index] = c; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return _s[index]; }
+    void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index = 0) const
+    {
+      if (!bufsize || !buf) return;
+      size_t n = (index < _s.length()) ? _s.copy((char *)buf, bufsize - 1, index) : 0;
+      buf[n] = 0;
+    }
+    void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const { getBytes((unsigned char *)buf, bufsize, index); }
+
+    int indexOf(char c, unsigned int from = 0) const { return toIndex(_s.find(c, from)); }
+    int indexOf(const String &s, unsigned int from = 0) const { return toIndex(_s.find(s._s, from)); }
+    int lastIndexOf(char c) const { return toIndex(_s.rfind(c)); }
+    String substring(unsigned int from) const { return (from < _s.length()) ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+      if (from > to) std::swap(from, to);
+      return (from < _s.length()) ? String(_s.substr(from, to - from)) : String();
+    }
+
+    void replace(const String &find, const String &replace)
+    {
+      if (find._s.empty()) return;
+      for (size_t pos = _s.find(find._s); pos != std::string::npos; pos = _s.find(find._s, pos + replace._s.length()))
+        _s.replace(pos, find._s.length(), replace._s);
+    }
+    void remove(unsigned int index, unsigned int count = (unsigned int)-1) { if (index < _s.length()) _s.erase(index, count); }
+    void trim()
+    {
+      size_t b = _s.find_first_not_of(" \t\r\n");
+      size_t e = _s.find_last_not_of(" \t\r\n");
+      _s = (b == std::string::npos) ? std::string() : _s.substr(b, e - b + 1);
+    }
+    void toLowerCase() { for (size_t i = 0; i < _s.length(); i++) _s[i] = tolower(_s[i]); }
+    void toUpperCase() { for (size_t i = 0; i < _s.length(); i++) _s[i] = toupper(_s[i]); }
+
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+
+  private:
+    static int toIndex(size_t pos) { return (pos == std::string::npos) ? -1 : (int)pos; }
+    static std::string fromInt(long value, unsigned char base)
+    {
+      if (base == 10) return std::to_string(value);
+      return fromUnsigned((unsigned long)value, base);
+    }
+    static std::string fromInt(unsigned long value, unsigned char base) { return fromUnsigned(value, base); }
+    static std::string fromInt(int value, unsigned char base) { return fromInt((long)value, base); }
+    static std::string fromInt(unsigned int value, unsigned char base) { return fromUnsigned(value, base); }
+    static std::string fromInt(unsigned char value, unsigned char base) { return fromUnsigned(value, base); }
+    static std::string fromUnsigned(unsigned long value, unsigned char base)
+    {
+      std::string s;
+      do { s.insert(s.begin(), "0123456789ABCDEF"[value % base]); value /= base; } while (value);
+      return s;
+    }
+    static std::string fromFloat(double value, unsigned char decimals)
+    {
+      char buf[48];
+      snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+      return buf;
+    }
+
+    std::string _s;
+};
+
+#endif
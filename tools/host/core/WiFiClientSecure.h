@@ -0,0 +1,20 @@
+/**
+  Host Arduino core
+  Name: WiFiClientSecure.h
+  Purpose: TLS client without a network
+*/
+
+#ifndef WiFiClientSecure_h
+#define WiFiClientSecure_h
+
+#include "ESP8266WiFi.h"
+
+class WiFiClientSecure : public WiFiClient
+{
+  public:
+    bool verify(const char *fingerprint, const char *domain_name) { return false; }
+    void setFingerprint(const char *fingerprint) {}
+    void setInsecure() {}
+};
+
+#endif
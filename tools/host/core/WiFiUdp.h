@@ -0,0 +1,29 @@
+/**
+  Host Arduino core
+  Name: WiFiUdp.h
+  Purpose: UDP without a network, no packet ever arrives
+*/
+
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+#include "ESP8266WiFi.h"
+
+class WiFiUDP : public Stream
+{
+  public:
+    uint8_t begin(uint16_t port) { return 1; }
+    void stop() {}
+    int beginPacket(IPAddress ip, uint16_t port) { return 1; }
+    int endPacket() { return 0; }
+    int parsePacket() { return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int read(unsigned char *buffer, size_t len) { return 0; }
+    int peek() { return -1; }
+    size_t write(uint8_t c) { return 1; }
+    size_t write(const uint8_t *buffer, size_t size) { return size; }
+    using Print::write;
+};
+
+#endif
@@ -0,0 +1,414 @@
+/**
+  Host Arduino core
+  Name: core.cpp
+  Purpose: Global objects, pins, time, recorded responses, SPI and flash file
+           system of the host core
+*/
+
+#include <map>
+#include <vector>
+#include "Arduino.h"
+#include "SPI.h"
+#include "ESP8266WiFi.h"
+#include "FS.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+SPIClass SPI;
+ESP8266WiFiClass WiFi;
+fs::FS SPIFFS;
+
+volatile uint32_t GPO = 0xFFFFFFFF;
+GPIOSetRegister GPOS;
+GPIOClearRegister GPOC;
+
+SPICommandRegister SPI1CMD;
+volatile uint32_t SPI1C, SPI1U, SPI1U1, SPI1U2, SPI1P, SPI1S, SPI1CLK;
+volatile uint32_t SPI1W[16];
+
+uint32_t hostSpiFrequency = 1000000;
+
+static unsigned long hostMicros = 0;
+
+
+// Pins
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (val) GPO |= digitalPinToBitMask(pin);
+  else     GPO &= ~digitalPinToBitMask(pin);
+}
+
+// Inputs are pulled up, so the touch IRQ never reports a touch
+int digitalRead(uint8_t pin)
+{
+  return HIGH;
+}
+
+int analogRead(uint8_t pin)
+{
+  return 0;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode)
+{
+}
+
+void detachInterrupt(uint8_t pin)
+{
+}
+
+
+// Time
+
+unsigned long millis(void)
+{
+  return hostMicros / 1000;
+}
+
+unsigned long micros(void)
+{
+  return hostMicros;
+}
+
+void delay(unsigned long ms)
+{
+  hostMicros += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  hostMicros += us;
+}
+
+void yield(void)
+{
+}
+
+
+// Number conversion
+
+char *ultoa(unsigned long value, char *result, int base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char *p = buf;
+  if ((base < 2) || (base > 36)) base = 10;
+  do { *p++ = "0123456789abcdefghijklmnopqrstuvwxyz"[value % base]; value /= base; } while (value);
+  char *out = result;
+  while (p > buf) *out++ = *--p;
+  *out = 0;
+  return result;
+}
+
+char *ltoa(long value, char *result, int base)
+{
+  if ((value < 0) && (base == 10))
+  {
+    *result = '-';
+    ultoa(-(unsigned long)value, result + 1, base);
+    return result;
+  }
+  return ultoa(value, result, base);
+}
+
+char *utoa(unsigned value, char *result, int base)
+{
+  return ultoa(value, result, base);
+}
+
+char *itoa(int value, char *result, int base)
+{
+  return ltoa(value, result, base);
+}
+
+char *dtostrf(double number, signed char width, unsigned char prec, char *s)
+{
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+
+// Random numbers, the same sequence on every run
+
+static unsigned long randomState = 1;
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0) randomState = seed;
+}
+
+long random(long howbig)
+{
+  if (howbig <= 0) return 0;
+  randomState = randomState * 1103515245 + 12345;
+  return (randomState >> 16) % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+
+// Stream
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length)
+  {
+    int c = read();
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
+
+String Stream::readStringUntil(char terminator)
+{
+  String ret;
+  int c = read();
+  while ((c >= 0) && (c != terminator))
+  {
+    ret += (char)c;
+    c = read();
+  }
+  return ret;
+}
+
+
+// Recorded responses
+
+static std::map<std::string, std::vector<uint8_t> > recordings;
+uint32_t hostReplayBytes = 0;
+
+bool hostReplay(const char *host, const char *file)
+{
+  FILE *f = fopen(file, "rb");
+  if (!f) return false;
+  std::vector<uint8_t> &data = recordings[host];
+  data.clear();
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+void hostReplayClear()
+{
+  recordings.clear();
+}
+
+wl_status_t ESP8266WiFiClass::status()
+{
+  return recordings.empty() ? WL_DISCONNECTED : WL_CONNECTED;
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+  stop();
+  std::map<std::string, std::vector<uint8_t> >::const_iterator r = recordings.find(host);
+  if (r == recordings.end()) return 0;
+  _rx = r->second.data();
+  _rxLen = r->second.size();
+  return 1;
+}
+
+int WiFiClient::read()
+{
+  if (!connected()) return -1;
+  hostReplayBytes++;
+  return _rx[_rxPos++];
+}
+
+int WiFiClient::read(uint8_t *buf, size_t size)
+{
+  size_t n = available();
+  if (size < n) n = size;
+  memcpy(buf, _rx + _rxPos, n);
+  _rxPos += n;
+  hostReplayBytes += n;
+  return n;
+}
+
+
+// SPI registers
+
+// Nothing on the bus, linking a device model such as ILI9341Sim replaces it
+__attribute__((weak)) uint8_t hostSpiTransfer(uint8_t out)
+{
+  return 0xFF;
+}
+
+/**
+  Sends the bits set in SPI1U1 from SPI1W0..15. MISO is not copied back to
+  SPI1W, TFT_eSPI reads the display with SPI.transfer().
+*/
+void SPICommandRegister::operator|=(uint32_t value)
+{
+  if (!(value & SPIBUSY)) return;
+
+  uint32_t bytes = ((((SPI1U1 >> SPILMOSI) & SPIMMOSI) + 1) + 7) / 8;
+  for (uint32_t i = 0; i < bytes; i++) hostSpiTransfer(SPI1W[i / 4] >> (8 * (i % 4)));
+}
+
+
+// SPI class
+
+void SPIClass::begin()
+{
+  SPI1U = SPIUMOSI | SPIUDUPLEX | SPIUSSE;
+  SPI1U1 = (7 << SPILMOSI) | (7 << SPILMISO);
+}
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+  uint16_t in = hostSpiTransfer(data >> 8) << 8;
+  return in | hostSpiTransfer(data);
+}
+
+void SPIClass::transferBytes(const uint8_t *out, uint8_t *in, uint32_t size)
+{
+  while (size--)
+  {
+    uint8_t b = hostSpiTransfer(out ? *out++ : 0xFF);
+    if (in) *in++ = b;
+  }
+}
+
+void SPIClass::write16(uint16_t data)
+{
+  write16(data, true);
+}
+
+void SPIClass::write16(uint16_t data, bool msb)
+{
+  if (msb)
+  {
+    hostSpiTransfer(data >> 8);
+    hostSpiTransfer(data);
+  }
+  else
+  {
+    hostSpiTransfer(data);
+    hostSpiTransfer(data >> 8);
+  }
+}
+
+void SPIClass::write32(uint32_t data)
+{
+  write32(data, true);
+}
+
+void SPIClass::write32(uint32_t data, bool msb)
+{
+  for (int i = 0; i < 4; i++) hostSpiTransfer(msb ? (data >> (24 - 8 * i)) : (data >> (8 * i)));
+}
+
+void SPIClass::writeBytes(const uint8_t *data, uint32_t size)
+{
+  while (size--) hostSpiTransfer(*data++);
+}
+
+void SPIClass::writePattern(const uint8_t *data, uint8_t size, uint32_t repeat)
+{
+  while (repeat--)
+  {
+    for (uint8_t i = 0; i < size; i++) hostSpiTransfer(data[i]);
+  }
+}
+
+
+// Flash file system
+
+const char *hostFsRoot = "/tmp/hostfs";
+
+static std::string hostFsPath(const char *path)
+{
+  return std::string(hostFsRoot) + "/" + ((*path == '/') ? path + 1 : path);
+}
+
+bool fs::FS::begin()
+{
+  std::string cmd = std::string("mkdir -p '") + hostFsRoot + "'";
+  return system(cmd.c_str()) == 0;
+}
+
+fs::File fs::FS::open(const char *path, const char *mode)
+{
+  std::string m = std::string(mode) + "b";
+  return File(fopen(hostFsPath(path).c_str(), m.c_str()));
+}
+
+bool fs::FS::exists(const char *path)
+{
+  FILE *f = fopen(hostFsPath(path).c_str(), "rb");
+  if (f) fclose(f);
+  return f != NULL;
+}
+
+bool fs::FS::remove(const char *path)
+{
+  return ::remove(hostFsPath(path).c_str()) == 0;
+}
+
+bool fs::FS::rename(const char *pathFrom, const char *pathTo)
+{
+  return ::rename(hostFsPath(pathFrom).c_str(), hostFsPath(pathTo).c_str()) == 0;
+}
+
+int fs::File::available()
+{
+  return _f ? (int)(size() - ftell(_f)) : 0;
+}
+
+int fs::File::read()
+{
+  return _f ? fgetc(_f) : -1;
+}
+
+size_t fs::File::read(uint8_t *buf, size_t size)
+{
+  return _f ? fread(buf, 1, size, _f) : 0;
+}
+
+int fs::File::peek()
+{
+  if (!_f) return -1;
+  int c = fgetc(_f);
+  if (c != EOF) ungetc(c, _f);
+  return c;
+}
+
+size_t fs::File::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t fs::File::write(const uint8_t *buf, size_t size)
+{
+  return _f ? fwrite(buf, 1, size, _f) : 0;
+}
+
+size_t fs::File::size()
+{
+  if (!_f) return 0;
+  long pos = ftell(_f);
+  fseek(_f, 0, SEEK_END);
+  long end = ftell(_f);
+  fseek(_f, pos, SEEK_SET);
+  return end;
+}
+
+void fs::File::close()
+{
+  if (_f) fclose(_f);
+  _f = NULL;
+}
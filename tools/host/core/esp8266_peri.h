@@ -0,0 +1,77 @@
+/**
+  Host Arduino core
+  Name: esp8266_peri.h
+  Purpose: The ESP8266 GPIO and SPI1 registers written by TFT_eSPI
+
+  Writing SPIBUSY to SPI1CMD clocks the bits set in SPI1U1 out of SPI1W0..15
+  at once, low byte of SPI1W0 first, and the transfer is done when it returns.
+  All SPI traffic goes to hostSpiTransfer(), which is implemented by the
+  display model.
+*/
+
+#ifndef esp8266_peri_h
+#define esp8266_peri_h
+
+#include <stdint.h>
+
+// Output level of all pins, bit n is GPIO n
+extern volatile uint32_t GPO;
+
+// GPOS sets and GPOC clears the pins of the mask written to them
+struct GPIOSetRegister
+{
+  void operator=(uint32_t mask) { GPO |= mask; }
+};
+
+struct GPIOClearRegister
+{
+  void operator=(uint32_t mask) { GPO &= ~mask; }
+};
+
+extern GPIOSetRegister GPOS;
+extern GPIOClearRegister GPOC;
+
+struct SPICommandRegister
+{
+  operator uint32_t() const { return 0; }   // Never busy
+  void operator|=(uint32_t value);
+};
+
+extern SPICommandRegister SPI1CMD;
+extern volatile uint32_t SPI1C, SPI1U, SPI1U1, SPI1U2, SPI1P, SPI1S, SPI1CLK;
+extern volatile uint32_t SPI1W[16];
+
+#define SPI1W0  SPI1W[0]
+#define SPI1W1  SPI1W[1]
+#define SPI1W2  SPI1W[2]
+#define SPI1W3  SPI1W[3]
+#define SPI1W4  SPI1W[4]
+#define SPI1W5  SPI1W[5]
+#define SPI1W6  SPI1W[6]
+#define SPI1W7  SPI1W[7]
+#define SPI1W8  SPI1W[8]
+#define SPI1W9  SPI1W[9]
+#define SPI1W10 SPI1W[10]
+#define SPI1W11 SPI1W[11]
+#define SPI1W12 SPI1W[12]
+#define SPI1W13 SPI1W[13]
+#define SPI1W14 SPI1W[14]
+#define SPI1W15 SPI1W[15]
+
+#define SPIBUSY    (1 << 18)
+#define SPIUMOSI   (1 << 27)
+#define SPIUMISO   (1 << 28)
+#define SPIUSSE    (1 << 5)
+#define SPIUDUPLEX (1 << 0)
+#define SPILMOSI   17
+#define SPIMMOSI   0x1FF
+#define SPILMISO   8
+#define SPIMMISO   0x1FF
+
+// One byte on the bus, returns the byte read at the same time
+uint8_t hostSpiTransfer(uint8_t out);
+
+// Clock set with SPI.setFrequency()
+extern uint32_t hostSpiFrequency;
+
+#endif
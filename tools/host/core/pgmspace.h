@@ -0,0 +1,32 @@
+/**
+  Host Arduino core
+  Name: pgmspace.h
+  Purpose: PROGMEM access, on the host the data is in RAM and read directly
+*/
+
+#ifndef pgmspace_h
+#define pgmspace_h
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) (s)
+#define FPSTR(p) (p)
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+// Used on pointers to font tables, which are 8 bytes here. The library keeps
+// some of them in uint32_t, so the program has to be linked with -no-pie.
+#define pgm_read_dword(addr) (*(const uintptr_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+
+#define memcpy_P  memcpy
+#define strcpy_P  strcpy
+#define strncpy_P strncpy
+#define strlen_P  strlen
+#define strcmp_P  strcmp
+
+#endif
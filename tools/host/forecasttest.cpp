@@ -0,0 +1,110 @@
+/**
+  Forecast window test on the host
+  Name: forecasttest.cpp
+  Purpose: Replays two DarkSky responses a few hours apart and checks that the
+           hours of today read by the first one are still shown after the second
+
+  Build and run from the repository root:
+    g++ -std=gnu++11 -O2 -DESP8266 -DARDUINO=10805 -Itools/host/core -Ilibraries/Time \
+      -IESP_InfoDisplay tools/host/forecasttest.cpp tools/host/core/core.cpp \
+      libraries/Time/Time.cpp ESP_InfoDisplay/HttpFetch.cpp ESP_InfoDisplay/GatewayRecord.cpp \
+      ESP_InfoDisplay/DarkSkyAPI.cpp ESP_InfoDisplay/DarkSkyAPI_DataListener.cpp -o forecasttest
+    ./forecasttest
+
+  The second response is tools/host/fixtures/darksky_48h.http with all times
+  moved FORECAST_TEST_SHIFT hours ahead. Its forecast starts FORECAST_TEST_SHIFT
+  hours later, the hours in between are only known from the first response.
+  Returns 0 if they are kept.
+*/
+
+#include <string>
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "DarkSkyAPI.h"
+
+#define FORECAST_TEST_SHIFT 3         // Hours between the two responses
+#define FORECAST_TEST_FIXTURE "tools/host/fixtures/darksky_48h.http"
+#define FORECAST_TEST_LATER   "/tmp/forecasttest_later.http"
+
+DarkSkyAPI Weather;
+
+
+static bool readFile(const char *file, std::string &s)
+{
+  FILE *f = fopen(file, "rb");
+  if (!f) return false;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+/**
+  Writes the response with every "time" moved by shift hours. The times keep
+  their number of digits, so Content-Length stays right.
+*/
+static bool writeShifted(const std::string &response, const char *file, uint32_t shift)
+{
+  std::string out;
+  size_t pos = 0, found;
+  while ((found = response.find("\"time\":", pos)) != std::string::npos)
+  {
+    found += 7;
+    out.append(response, pos, found - pos);
+    char *end;
+    uint32_t time = strtoul(response.c_str() + found, &end, 10);
+    out += std::to_string(time + 3600 * shift);
+    pos = end - response.c_str();
+  }
+  out.append(response, pos, std::string::npos);
+
+  FILE *f = fopen(file, "wb");
+  if (!f) return false;
+  bool ok = fwrite(out.data(), 1, out.length(), f) == out.length();
+  return (fclose(f) == 0) && ok;
+}
+
+static bool query(const char *file)
+{
+  hostReplayClear();
+  return hostReplay("api.darksky.net", file) && Weather.queryWeather(DarkSkyAPI::Location::Kiel);
+}
+
+int main()
+{
+  std::string response;
+  if (!readFile(FORECAST_TEST_FIXTURE, response) || !writeShifted(response, FORECAST_TEST_LATER, FORECAST_TEST_SHIFT))
+  {
+    fprintf(stderr, "forecasttest: can't prepare %s\n", FORECAST_TEST_LATER);
+    return 2;
+  }
+
+  if (!query(FORECAST_TEST_FIXTURE))
+  {
+    fprintf(stderr, "forecasttest: first query failed\n");
+    return 2;
+  }
+  uint32_t firstHour = Weather.listener.getCurrentTime() / 3600;
+  int16_t temp[FORECAST_TEST_SHIFT];
+  for (uint8_t i = 0; i < FORECAST_TEST_SHIFT; i++) temp[i] = Weather.listener.getFutureTemp(firstHour + i);
+
+  if (!query(FORECAST_TEST_LATER))
+  {
+    fprintf(stderr, "forecasttest: second query failed\n");
+    return 2;
+  }
+  uint32_t startHour = Weather.listener.getStartHour();
+  const WeatherForecast &w = Weather.readWeather();
+
+  int failed = 0;
+  for (uint8_t i = 0; i < FORECAST_TEST_SHIFT; i++)
+  {
+    uint32_t hour = firstHour + i;
+    bool kept = Weather.listener.hasFuture(hour) && (w.fTemp[hour - startHour] == temp[i]);
+    printf("hour %2u: %s\n", (unsigned)(hour - startHour), kept ? "kept" : "lost");
+    if (!kept) failed++;
+  }
+  printf("%s\n", failed ? "FAILED" : "OK");
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,258 @@
+/**
+  Gateway for several displays
+  Name: gateway.cpp
+  Purpose: Reads KVG and DarkSky once for all displays and serves each display
+           only the departures and the forecast it shows
+
+  Build and run from the repository root:
+    g++ -std=gnu++11 -O2 -DESP8266 -DARDUINO=10805 -Itools/host/core -Ilibraries/Time \
+      -IESP_InfoDisplay tools/host/gateway.cpp tools/host/core/core.cpp \
+      libraries/Time/Time.cpp ESP_InfoDisplay/HttpFetch.cpp ESP_InfoDisplay/GatewayRecord.cpp \
+      ESP_InfoDisplay/KVGliveAPI.cpp ESP_InfoDisplay/KVGliveAPI_DataListener.cpp \
+      ESP_InfoDisplay/DarkSkyAPI.cpp ESP_InfoDisplay/DarkSkyAPI_DataListener.cpp -o gateway
+    ./gateway [-p port]
+
+  Set GATEWAY_HOST in ESP_InfoDisplay.ino to the address of this host. The
+  displays then ask for
+    GET /stop/<number>       departures of a KVG stop, up to 621 bytes
+    GET /weather/<lat,lon>   forecast of a location, 346 bytes
+  and get the records of GatewayRecord instead of about 30 KB of JSON.
+
+  The upstream responses are fetched with curl and replayed by the host core
+  to KVGliveAPI and DarkSkyAPI, so they are read by the same code as on the
+  display. A record is kept for GATEWAY_STOP_AGE or GATEWAY_WEATHER_AGE, all
+  displays asking in that time share one upstream query. If a query fails,
+  the last record is served. Every record has an ETag, a request with a
+  matching If-None-Match gets "304 Not Modified" without the record.
+*/
+
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "KVGliveAPI.h"
+#include "DarkSkyAPI.h"
+#include "GatewayRecord.h"
+
+#define GATEWAY_PORT        8080
+#define GATEWAY_STOP_AGE    10        // Seconds a stop is served without asking KVG again
+#define GATEWAY_WEATHER_AGE 600       // Seconds a forecast is served without asking DarkSky again
+#define GATEWAY_FETCH_TIME  10        // Seconds an upstream query may take
+#define GATEWAY_REQUEST_MAX 2048      // Longest request of a display that is read
+#define GATEWAY_RESPONSE_FILE "/tmp/gateway_response.http"
+
+struct Record
+{
+  uint8_t data[GATEWAY_RECORD_MAX];
+  size_t length = 0;              // 0 until a query succeeded
+  uint32_t etag;
+  int64_t fetched = -1;           // Seconds of the last query
+};
+
+KVGliveAPI KVG;
+// Each location has its own API, the forecast of today's earlier hours is kept from query to query
+std::map<std::string, DarkSkyAPI *> locations;
+std::map<std::string, KVGbusStop> stops;
+std::map<std::string, Record> records;  // By path
+
+
+static int64_t seconds()
+{
+  return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+  Fetches url and hands the response to the clients connecting to host. The
+  argument has been checked to hold no quotes.
+*/
+static bool fetch(const char *host, const String &url)
+{
+  char cmd[512];
+  snprintf(cmd, sizeof(cmd), "curl --http1.0 -si --max-time %d '%s' > '%s'", GATEWAY_FETCH_TIME, url.c_str(), GATEWAY_RESPONSE_FILE);
+  hostReplayClear();
+  return (system(cmd) == 0) && hostReplay(host, GATEWAY_RESPONSE_FILE);
+}
+
+static bool queryStop(const std::string &number, Record &record)
+{
+  if (!fetch("kvg-kiel.de", String("http://kvg-kiel.de") + KVG.queryPath(atoi(number.c_str())))) return false;
+
+  // The stop name is kept, as in KVGStopCache
+  KVGbusStop &stop = stops[number];
+  if (!KVG.beginQuery(atoi(number.c_str()), stop)) return false;
+  while (KVG.busy()) KVG.update(100);
+  if (KVG.update(0) != HttpFetch::DONE) return false;
+  record.length = GatewayRecord::writeBusStop(record.data, stop);
+  return true;
+}
+
+static bool queryWeather(const std::string &location, Record &record)
+{
+  DarkSkyAPI *&api = locations[location];
+  if (!api) api = new DarkSkyAPI();
+  if (!fetch("api.darksky.net", String("https://api.darksky.net") + api->queryPath(location.c_str()))) return false;
+  if (!api->queryWeather(location.c_str())) return false;
+
+  uint32_t localTime = api->listener.getCurrentTime() + 60 * api->listener.getOffset();
+  record.length = GatewayRecord::writeWeather(record.data, api->readWeather(), localTime);
+  return true;
+}
+
+// Only digits and the characters of a location, they are passed to the shell
+static bool isArgument(const std::string &s, const char *allowed)
+{
+  return !s.empty() && (s.find_first_not_of(allowed) == std::string::npos);
+}
+
+/**
+  Returns the record of path, queried again if it is too old. NULL if the
+  path is unknown or there has never been an answer.
+*/
+static Record *findRecord(const std::string &path)
+{
+  bool isStop = (path.compare(0, 6, "/stop/") == 0);
+  bool isWeather = (path.compare(0, 9, "/weather/") == 0);
+  std::string arg = path.substr(path.find('/', 1) + 1);
+  if (isStop ? !isArgument(arg, "0123456789") : (!isWeather || !isArgument(arg, "0123456789.,-"))) return NULL;
+
+  Record &record = records[path];
+  int64_t age = isStop ? GATEWAY_STOP_AGE : GATEWAY_WEATHER_AGE;
+  if ((record.fetched < 0) || (seconds() - record.fetched >= age))
+  {
+    Record fresh;
+    if (isStop ? queryStop(arg, fresh) : queryWeather(arg, fresh))
+    {
+      fresh.etag = fnv1a(FNV1A_BASIS, fresh.data, fresh.length);
+      fresh.fetched = seconds();
+      record = fresh;
+    }
+    else
+    {
+      printf("%s: upstream query failed\n", path.c_str());
+      // Keep serving the last record, ask again after GATEWAY_FETCH_TIME
+      if (record.length > 0) record.fetched = seconds() - age + GATEWAY_FETCH_TIME;
+    }
+  }
+  return (record.length > 0) ? &record : NULL;
+}
+
+/**
+  Value of a header of the request, empty if it is not there.
+*/
+static std::string header(const std::string &request, const char *name)
+{
+  std::string lower = request;
+  std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+  size_t pos = lower.find(std::string("\r\n") + name + ":");
+  if (pos == std::string::npos) return std::string();
+  pos += strlen(name) + 3;
+  size_t end = request.find("\r\n", pos);
+  size_t start = request.find_first_not_of(' ', pos);
+  return request.substr(start, end - start);
+}
+
+static void sendAll(int fd, const char *data, size_t length)
+{
+  while (length > 0)
+  {
+    ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+    if (n <= 0) return;
+    data += n;
+    length -= n;
+  }
+}
+
+/**
+  Reads one request of a display and answers it.
+*/
+static void serve(int fd)
+{
+  std::string request;
+  char buf[512];
+  while ((request.find("\r\n\r\n") == std::string::npos) && (request.length() < GATEWAY_REQUEST_MAX))
+  {
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) return;
+    request.append(buf, n);
+  }
+
+  char response[256];
+  int status = 400;
+  Record *record = NULL;
+  std::string path;
+  if (request.compare(0, 4, "GET ") == 0)
+  {
+    path = request.substr(4, request.find(' ', 4) - 4);
+    record = findRecord(path);
+    status = record ? 200 : 404;
+    // A stop or location that is known but can't be read
+    if (!record && (records.count(path) > 0)) status = 502;
+  }
+
+  if (record)
+  {
+    char etag[16];
+    snprintf(etag, sizeof(etag), "\"%08x\"", record->etag);
+    if (header(request, "if-none-match") == etag) status = 304;
+    snprintf(response, sizeof(response), "HTTP/1.0 %s\r\nContent-Type: application/octet-stream\r\n"
+             "Content-Length: %u\r\nETag: %s\r\nConnection: close\r\n\r\n",
+             (status == 200) ? "200 OK" : "304 Not Modified", (status == 200) ? (unsigned)record->length : 0, etag);
+    sendAll(fd, response, strlen(response));
+    if (status == 200) sendAll(fd, (const char *)record->data, record->length);
+  }
+  else
+  {
+    snprintf(response, sizeof(response), "HTTP/1.0 %d %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+             status, (status == 404) ? "Not Found" : (status == 502) ? "Bad Gateway" : "Bad Request");
+    sendAll(fd, response, strlen(response));
+  }
+  printf("GET %s %d %u\n", path.c_str(), status, (status == 200) ? (unsigned)record->length : 0);
+  fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+  int port = GATEWAY_PORT;
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc)) port = atoi(argv[++i]);
+    else
+    {
+      fprintf(stderr, "usage: %s [-p port]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  int server = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(port);
+  if ((server < 0) || (bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0) || (listen(server, 8) < 0))
+  {
+    perror("gateway");
+    return 1;
+  }
+  printf("gateway on port %d\n", port);
+  fflush(stdout);
+
+  // One display after the other, a display waits at most for one upstream query
+  while (true)
+  {
+    int fd = accept(server, NULL, NULL);
+    if (fd < 0) continue;
+    struct timeval timeout = {2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    serve(fd);
+    close(fd);
+  }
+}
@@ -0,0 +1,198 @@
+/**
+  Parser benchmark on the host
+  Name: parsebench.cpp
+  Purpose: Replays recorded KVG and DarkSky responses through KVGliveAPI and
+           DarkSkyAPI and reports the time per byte and the heap use of a parse
+
+  Build and run from the repository root:
+    g++ -std=gnu++11 -O2 -DESP8266 -DARDUINO=10805 -Itools/host/core -Ilibraries/Time \
+      -IESP_InfoDisplay tools/host/parsebench.cpp tools/host/core/core.cpp \
+      libraries/Time/Time.cpp ESP_InfoDisplay/HttpFetch.cpp ESP_InfoDisplay/GatewayRecord.cpp \
+      ESP_InfoDisplay/KVGliveAPI.cpp ESP_InfoDisplay/KVGliveAPI_DataListener.cpp \
+      ESP_InfoDisplay/DarkSkyAPI.cpp ESP_InfoDisplay/DarkSkyAPI_DataListener.cpp -o parsebench
+    ./parsebench [-v] [file ...]
+
+  Files named kvg_* are answers of kvg-kiel.de, all others of api.darksky.net.
+  Files named *_cut.http are cut off responses, their request has to fail,
+  must not keep the ETag and is not timed. Without files the recordings in tools/host/fixtures are used,
+  -v prints what was parsed. A parse is the whole request: HTTP headers, JSON and listener.
+  Allocations are those of operator new, String is std::string on the host,
+  so the numbers show trends but not the heap use on the ESP8266.
+*/
+
+#include <chrono>
+#include <new>
+#include <Arduino.h>
+#include "KVGliveAPI.h"
+#include "DarkSkyAPI.h"
+
+#define BENCH_MIN_TIME_NS  200000000  // Repeat each parse for at least 0.2s
+#define BENCH_MIN_ITERATIONS 10
+#define HEAP_HEADER 16                // Size in front of every block, keeps the alignment
+
+static const char *fixtures[] = {
+  "tools/host/fixtures/kvg_quiet.http",
+  "tools/host/fixtures/kvg_hbf.http",
+  "tools/host/fixtures/kvg_cancelled.http",
+  "tools/host/fixtures/darksky_48h.http",
+  "tools/host/fixtures/darksky_extended.http",
+  "tools/host/fixtures/kvg_hbf_cut.http",
+  "tools/host/fixtures/kvg_hbf_length_cut.http",
+  "tools/host/fixtures/darksky_48h_cut.http",
+};
+
+KVGliveAPI KVG;
+DarkSkyAPI Weather;
+
+
+// Heap use, every block carries its size in front
+
+static size_t heapLive = 0;
+static size_t heapPeak = 0;
+static uint32_t heapAllocs = 0;
+
+void *operator new(size_t size)
+{
+  size_t *p = (size_t *)malloc(size + HEAP_HEADER);
+  if (!p) throw std::bad_alloc();
+  *p = size;
+  heapAllocs++;
+  heapLive += size;
+  if (heapLive > heapPeak) heapPeak = heapLive;
+  return (char *)p + HEAP_HEADER;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  if (!ptr) return;
+  size_t *p = (size_t *)((char *)ptr - HEAP_HEADER);
+  heapLive -= *p;
+  free(p);
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t size) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t size) noexcept { operator delete(ptr); }
+
+
+static bool isKVG(const char *file)
+{
+  const char *name = strrchr(file, '/');
+  return strncmp(name ? name + 1 : file, "kvg_", 4) == 0;
+}
+
+static bool isCut(const char *file)
+{
+  return strstr(file, "_cut.") != NULL;
+}
+
+/**
+  One complete request, the bus stop starts empty so the whole response is
+  read every time. True if the request is DONE with data. The validator is
+  only sent to kvg-kiel.de, DarkSkyAPI takes none.
+*/
+static bool parse(const char *file, bool print, HttpValidator *validator = NULL)
+{
+  if (isKVG(file))
+  {
+    KVGbusStop stop;
+    KVG.beginQuery(KVGliveAPI::KVGstop::Wrangelstrasse, stop, validator);
+    while (KVG.busy()) KVG.update(100);
+    if (print)
+    {
+      printf("%s:\n", stop.stopName.c_str());
+      for (int row = 0; row < KVG_DEPARTURES; row++)
+      {
+        KVGbus &bus = stop.departures[row];
+        printf("  %-4s %-24s %s %3d min %+d\n", bus.number.c_str(), bus.dir.c_str(), bus.depTime.c_str(), bus.depMinutes, bus.depDelay);
+      }
+    }
+    return (KVG.update(0) == HttpFetch::DONE) && (stop.departures[0].number.length() > 0);
+  }
+
+  bool ok = Weather.queryWeather(DarkSkyAPI::Location::Kiel);
+  if (print) printf("%s", Weather.printWeather().c_str());
+  return ok;
+}
+
+static int64_t nanos()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char *argv[])
+{
+  bool verbose = false;
+  int nFiles = 0;
+  const char **files = fixtures;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-v") == 0) verbose = true;
+    else argv[nFiles++] = argv[i];
+  }
+  if (nFiles > 0) files = (const char **)argv;
+  else nFiles = sizeof(fixtures) / sizeof(fixtures[0]);
+
+  printf("%-24s %11s %10s %8s %8s %7s %10s\n", "Benchmark", "Time", "Iterations", "Bytes", "ns/byte", "Allocs", "Peak heap");
+
+  int failed = 0;
+  for (int f = 0; f < nFiles; f++)
+  {
+    const char *file = files[f];
+    const char *name = strrchr(file, '/') ? strrchr(file, '/') + 1 : file;
+    hostReplayClear();
+    if (!hostReplay(isKVG(file) ? "kvg-kiel.de" : "api.darksky.net", file))
+    {
+      fprintf(stderr, "%s: can't read\n", file);
+      failed++;
+      continue;
+    }
+
+    // A cut off response has to fail and must not leave its ETag for the next request
+    if (isCut(file))
+    {
+      HttpValidator validator;
+      if (isKVG(file)) strcpy(validator.etag, "\"old\"");
+      bool ok = parse(file, false, &validator);
+      bool kept = isKVG(file) && (validator.etag[0] || validator.lastModified[0]);
+      printf("%-24s %11s\n", name, ok ? "DONE" : "FAILED");
+      if (ok || kept)
+      {
+        fprintf(stderr, "%s: cut off response accepted\n", file);
+        failed++;
+      }
+      continue;
+    }
+
+    // First parse for the heap use and the result
+    hostReplayBytes = 0;
+    size_t heapStart = heapLive;
+    heapPeak = heapLive;
+    heapAllocs = 0;
+    bool ok = parse(file, verbose);
+    uint32_t bytes = hostReplayBytes;
+    uint32_t allocs = heapAllocs;
+    size_t peak = heapPeak - heapStart;
+    if (!ok)
+    {
+      fprintf(stderr, "%s: no data parsed\n", file);
+      failed++;
+    }
+
+    int64_t start = nanos();
+    int64_t elapsed = 0;
+    uint32_t iterations = 0;
+    while ((elapsed < BENCH_MIN_TIME_NS) || (iterations < BENCH_MIN_ITERATIONS))
+    {
+      parse(file, false);
+      iterations++;
+      elapsed = nanos() - start;
+    }
+
+    double perParse = (double)elapsed / iterations;
+    printf("%-24s %8.0f ns %10u %8u %8.2f %7u %10u\n", name, perParse, iterations, bytes, perParse / bytes, allocs, (uint32_t)peak);
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+/**
+  Display benchmark on the host
+  Name: tftbench.cpp
+  Purpose: Draws the screens of ESP_InfoDisplay into the ILI9341 model, prints the
+           SPI traffic of every frame and compares the frames with golden images
+
+  Build and run from the repository root:
+    g++ -std=gnu++11 -O2 -no-pie -DESP8266 -DARDUINO=10805 -Itools/host/core -Itools/host \
+      -Ilibraries/TFT_eSPI -Ilibraries/Time -Ilibraries/XPT2046 -IESP_InfoDisplay \
+      tools/host/tftbench.cpp tools/host/ILI9341Sim.cpp tools/host/core/core.cpp \
+      libraries/TFT_eSPI/TFT_eSPI.cpp libraries/Time/Time.cpp \
+      libraries/XPT2046/XPT2046.cpp ESP_InfoDisplay/Display.cpp -o tftbench
+    ./tftbench -o frames     Writes every frame to frames/<name>.png
+    ./tftbench -g golden     Compares every frame with golden/<name>.png
+
+  The exit code is 1 if a frame differs from its golden image or the image is
+  missing. The bus time is the time the bytes take at the SPI clock set by the
+  sketch, waiting for the CPU is not included.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <TimeLib.h>
+#include <TFT_eSPI.h>
+#include <XPT2046.h>
+#include "Display.h"
+#include "ILI9341Sim.h"
+
+TFT_eSPI tft = TFT_eSPI();
+XPT2046 touch(D2, D1);
+
+Base B(&tft, &touch);
+Clock clk(&B);
+BusScreen bus(&B);
+WeatherScreen wscr(&B);
+
+WeatherForecast weather;
+KVGbusStop stop;
+
+static const char *outDir = NULL;
+static const char *goldenDir = NULL;
+static int failed = 0;
+
+/**
+  Prints the traffic since the last frame and writes or compares its image.
+*/
+void endFrame(const char *name)
+{
+  const ILI9341Sim::Stats &s = tftSim.stats();
+  printf("%-16s %8u %9u %8u %9u %9.2f\n", name, s.commands, s.dataBytes, s.windows, s.pixels,
+         tftSim.busMicros(hostSpiFrequency) / 1000.0);
+
+  char file[256];
+  if (outDir)
+  {
+    snprintf(file, sizeof(file), "%s/%s.png", outDir, name);
+    if (!tftSim.writePNG(file)) fprintf(stderr, "%s: can't write\n", file);
+  }
+  if (goldenDir)
+  {
+    snprintf(file, sizeof(file), "%s/%s.png", goldenDir, name);
+    int32_t differ = tftSim.comparePNG(file);
+    if (differ < 0) fprintf(stderr, "%s: missing or not written by tftbench\n", file);
+    else if (differ > 0) fprintf(stderr, "%s: %d pixels differ\n", file, differ);
+    if (differ != 0) failed++;
+  }
+
+  tftSim.resetStats();
+}
+
+// A forecast that looks like a summer day in Kiel
+void setWeather()
+{
+  static const int16_t temp[24] = {121, 118, 115, 113, 112, 113, 118, 126, 135, 144, 152, 159,
+                                   165, 170, 173, 174, 172, 168, 161, 152, 143, 135, 129, 124};
+  static const uint8_t rain[24] = {0, 0, 0, 0, 0, 1, 3, 6, 4, 2, 0, 0,
+                                   0, 0, 2, 9, 14, 8, 3, 1, 0, 0, 0, 0};
+
+  weather.changed = WEATHER_CHANGED_ALL;
+  weather.actIco = ICON_PARTLY_CLOUDY_DAY;
+  weather.actTemp = 173;
+  weather.actWindSpd = 18;
+  weather.actWindDir = 176;
+  for (int i = 0; i < 48; i++)
+  {
+    weather.fTemp[i] = temp[i % 24] + 10 * (i / 24);
+    weather.fRainInt[i] = rain[i % 24];
+    weather.fRainProb[i] = rain[i % 24] ? 20 + 5 * rain[i % 24] : 0;
+    weather.fWindSpd[i] = 12 + (i * 7) % 15;
+    weather.fWindDir[i] = 160 + 2 * i;
+    weather.fCloudCover[i] = (i * 13) % 100;
+  }
+}
+
+void setDeparture(int row, const char *number, const char *dir, const char *depTime, int8_t minutes, int8_t delay)
+{
+  stop.departures[row].number = number;
+  stop.departures[row].dir = dir;
+  stop.departures[row].depTime = depTime;
+  stop.departures[row].depMinutes = minutes;
+  stop.departures[row].depDelay = delay;
+}
+
+void setBusStop()
+{
+  stop.stopName = "Wrangelstra\xc3\x9f" "e";
+  setDeparture(0, "41", "Dietrichsdorf", "14:07", 1, 0);
+  setDeparture(1, "42", "Hassee", "14:09", 3, 2);
+  setDeparture(2, "100", "Kronshagen", "14:14", 8, 0);
+  setDeparture(3, "41", "Hbf", "14:22", 16, 0);
+  setDeparture(4, "91", "Wellsee", "14:31", 25, 0);
+  setDeparture(5, "42", "Dietrichsdorf", "14:38", -2, 0);
+}
+
+void showClock()
+{
+  clk.updateTime((TimeOfDay) {(uint8_t)hour(), (uint8_t)minute(), (uint8_t)second()});
+  clk.Draw();
+}
+
+int main(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) outDir = argv[++i];
+    else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc)) goldenDir = argv[++i];
+    else
+    {
+      fprintf(stderr, "usage: %s [-o dir] [-g dir]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  printf("%-16s %8s %9s %8s %9s %9s\n", "frame", "commands", "data", "windows", "pixels", "bus ms");
+
+  B.initDispAndTouch();
+  endFrame("init");
+
+  // Weather screen
+  setTime(14, 5, 30, 16, 8, 2017);
+  setWeather();
+  wscr.updateWeather(weather);
+  wscr.Draw();
+  endFrame("weather_full");
+
+  wscr.Draw();
+  endFrame("weather_idle");
+
+  setTime(15, 0, 0, 16, 8, 2017);
+  wscr.Draw();
+  endFrame("weather_hour");
+
+  weather.changed = WEATHER_CHANGED_TEMP | WEATHER_CHANGED_FTEMP;
+  weather.actTemp = 168;
+  weather.fTemp[18] = 170;
+  wscr.updateWeather(weather);
+  wscr.Draw();
+  endFrame("weather_update");
+
+  // Bus stop screen with the clock, as after a touch
+  setTime(14, 5, 59, 16, 8, 2017);
+  setBusStop();
+  B.beginTransition();
+  bus.setReDrawFlag();
+  clk.setReDrawFlag();
+  bus.updateBusStop(stop);
+  bus.Draw();
+  showClock();
+  B.endTransition();
+  endFrame("bus_full");
+
+  setTime(14, 6, 0, 16, 8, 2017);
+  showClock();
+  endFrame("clock_minute");
+
+  setTime(14, 6, 1, 16, 8, 2017);
+  showClock();
+  endFrame("clock_second");
+
+  // The first bus has left, the others move up one row
+  for (int row = 0; row < 5; row++) stop.departures[row] = stop.departures[row + 1];
+  setDeparture(5, "100", "Kronshagen", "14:44", -2, 0);
+  for (int row = 0; row < 4; row++) stop.departures[row].depMinutes--;
+  bus.updateBusStop(stop);
+  bus.Draw();
+  endFrame("bus_update");
+
+  // Back to the weather screen with a touch
+  B.beginTransition();
+  wscr.setReDrawFlag();
+  wscr.Draw();
+  B.endTransition();
+  endFrame("weather_switch");
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+  XBM to RLE icon converter
+  Name: xbm2rle.py
+  Purpose: Converts the 1 bit PROGMEM images of icons.h to the 8 bit run length
+           encoding of the TFT_eSPI RLE fonts, drawn with TFT_eSPI::drawRLE().
+
+  Usage: python3 tools/xbm2rle.py ESP_InfoDisplay/icons.h ESP_InfoDisplay/icons_rle.h
+
+  Each byte is one run of 1 to 128 pixels, bit 7 set for the foreground colour
+  and bits 0-6 the run length - 1. Runs continue over the end of a row, the
+  padding bits of the XBM rows are dropped. Image "Name_bits" gets its size
+  from "Name_width" and "Name_height", or from "Prefix_width" and
+  "Prefix_height" with Prefix the part of the name before the first "_".
+"""
+
+import re
+import sys
+
+
+def read_images(source):
+    defines = dict(re.findall(r'#define\s+(\w+)\s+(\d+)', source))
+    images = []
+    for name, body in re.findall(r'(\w+)_bits\s*\[\]\s*PROGMEM\s*=\s*\{(.*?)\}', source, re.S):
+        prefix = name.split('_')[0]
+        for base in (name, prefix):
+            if base + '_width' in defines and base + '_height' in defines:
+                width = int(defines[base + '_width'])
+                height = int(defines[base + '_height'])
+                break
+        else:
+            sys.exit('No size for ' + name + '_bits')
+        data = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', body)]
+        if len(data) != (width + 7) // 8 * height:
+            sys.exit('Size of ' + name + '_bits does not match ' + str(width) + 'x' + str(height))
+        images.append((name, width, height, data))
+    return images, defines
+
+
+def pixels(width, height, data):
+    stride = (width + 7) // 8
+    for y in range(height):
+        for x in range(width):
+            yield (data[y * stride + x // 8] >> (7 - x % 8)) & 1
+
+
+def encode(width, height, data):
+    runs = []
+    last, count = None, 0
+    for p in pixels(width, height, data):
+        if p == last and count < 128:
+            count += 1
+            continue
+        if count:
+            runs.append((0x80 if last else 0x00) | (count - 1))
+        last, count = p, 1
+    runs.append((0x80 if last else 0x00) | (count - 1))
+    return runs
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[1]) as f:
+        images, defines = read_images(f.read())
+
+    out = ['/**',
+           '  Run length encoded icons in program memory',
+           '  Name: icons_rle.h',
+           '  Purpose: WiFi, Clock and Weather logo. Icons for different weather conditions.',
+           '',
+           '  Generated from icons.h by tools/xbm2rle.py, do not edit.',
+           '*/',
+           '',
+           '#pragma once',
+           '']
+    sizes = set()
+    total_bits, total_rle = 0, 0
+    for name, width, height, data in images:
+        runs = encode(width, height, data)
+        total_bits += len(data)
+        total_rle += len(runs)
+        base = name if (name + '_width') in defines else name.split('_')[0]
+        if base not in sizes:
+            sizes.add(base)
+            out.append('#define %s_width %d' % (base, width))
+            out.append('#define %s_height %d' % (base, height))
+        out.append('// %d bytes, %d as bitmap' % (len(runs), len(data)))
+        out.append('const uint8_t %s_rle[] PROGMEM = {' % name)
+        for i in range(0, len(runs), 16):
+            out.append(',' .join('0x%02x' % r for r in runs[i:i + 16]) + (',' if i + 16 < len(runs) else ''))
+        out.append('};')
+        out.append('')
+
+    with open(sys.argv[2], 'w') as f:
+        f.write('\n'.join(out))
+    print('%d images, %d bytes (bitmaps %d bytes)' % (len(images), total_rle, total_bits))
+
+
+if __name__ == '__main__':
+    main()